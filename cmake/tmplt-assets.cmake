@@ -59,6 +59,25 @@ function(apply_assets_processing_standalone)
     copy_assets(${STANDALONE_NAME} "${ASSET_SOURCE_DIR}" "${ASSET_BUILD_DIR}")
     install(DIRECTORY ${ASSET_SOURCE_DIR} DESTINATION ${INSTALL_DESTINATION})
 
+    # Prebuild the binary verse index (kralicky.idx) next to the copied and installed assets, the
+    # library maps it on start and only falls back to scanning the text when it is stale
+    if(EXISTS "${ASSET_SOURCE_DIR}/kralicky.txt" AND NOT CMAKE_CROSSCOMPILING)
+        add_custom_command(
+            TARGET ${STANDALONE_NAME}
+            POST_BUILD
+            COMMAND $<TARGET_FILE:${STANDALONE_NAME}> --index
+            COMMENT "Building verse index kralicky.idx")
+        # the staged binary under DESTDIR, a failed run leaves the installed assets without
+        # the index
+        install(
+            CODE "execute_process(
+                      COMMAND \"\$ENV{DESTDIR}\${CMAKE_INSTALL_PREFIX}/bin/${STANDALONE_NAME}\" --index
+                      RESULT_VARIABLE VERSE_INDEX_RESULT)
+                  if(NOT VERSE_INDEX_RESULT EQUAL 0)
+                      message(WARNING \"Verse index kralicky.idx was not installed: \${VERSE_INDEX_RESULT}\")
+                  endif()")
+    endif()
+
     # Set compilation definitions for asset paths
     target_compile_definitions(
         ${STANDALONE_NAME}
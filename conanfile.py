@@ -30,7 +30,6 @@ class DotNameCppRecipe(ConanFile):
     def requirements(self):
         self.requires("fmt/[~11.1]") # required by cpm package
         self.requires("zlib/[~1.3]")
-        self.requires("tinyxml2/11.0.0")
         # self.requires("nlohmann_json/[~3.11]")
         # self.requires("yaml-cpp/0.8.0")
         self.requires("opus/1.5.2")
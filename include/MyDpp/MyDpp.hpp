@@ -8,17 +8,38 @@
 #include <Sunriset/Sunriset.hpp>
 #include <MyDpp/version.h>
 #include <dpp/dpp.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <filesystem>
+#include <functional>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <random>
 #include <string>
+#include <thread>
 #include <vector>
 
 // Public API
 
 namespace dotname {
 
+  class AsyncHttpClient;
+  class ChannelJobs;
+  class CommandLatency;
+  class FeedAggregator;
+  template <typename Item> class FeedStore;
+  class HttpClient;
+  class Scheduler;
+  class SendQueue;
+  class SystemInfo;
+  template <typename Value> class TtlCache;
+  class VerseIndex;
+  class ValidatorStore;
+  class VerseSearch;
+  class WorkerPool;
+
   class MyDpp {
 
     const std::string libName = std::string ("MyDpp v.") + MYDPP_VERSION;
@@ -65,7 +86,7 @@ namespace dotname {
       std::string getLink () const {
         return link;
       }
-      std::vector<RSSItem> getItems () const {
+      const std::vector<RSSItem>& getItems () const {
         return items;
       }
 
@@ -75,8 +96,15 @@ namespace dotname {
 
     MyDpp ();
     MyDpp (const std::filesystem::path& assetsPath);
+    // Shuts down unless that already happened
     ~MyDpp ();
 
+    // Stops the jobs, waits for the messages already sent and stops the cluster, all
+    // within timeout; false when something was still running. Only the first call counts.
+    bool shutdown (std::chrono::milliseconds timeout);
+    // Shutdown from an event handler, runs on a thread of its own
+    void requestShutdown ();
+
     const std::filesystem::path getAssetsPath () const {
       return assetsPath_;
     }
@@ -86,12 +114,14 @@ namespace dotname {
 
     std::string getEnvironmentInfo ();
     bool loadVariousBotCommands ();
-    bool startPollingSunriset ();
+    // Posts the jobs (verse, btc, czk, sunriset, fortune) channels subscribed to, see
+    // assets/jobs.txt and /subscribe
+    bool startPollingChannelJobs ();
+    // False when the emojies are already sent, respectively already stopped
     bool startPollingEmojies ();
-    bool startPollingFortune ();
-    bool startPollingBTCPrice ();
-    bool startPollingCZExchRate ();
-    bool startPollingGetBibleVerse ();
+    bool stopPollingEmojies ();
+    // Posts new items of the feeds subscribed in assets/feeds.txt to their channels
+    bool startPollingFeeds ();
 
     bool welcomeWithFastfetch ();
     bool welcomeWithNeofetch ();
@@ -99,25 +129,83 @@ namespace dotname {
     bool getToken (std::string& token, const std::string& filePath);
 
     std::string getLinuxFortuneCpp ();
+    // What fastfetch / neofetch would report, read natively without a process
     std::string getLinuxFastfetchCpp ();
     std::string getLinuxNeofetchCpp ();
     std::string getBitcoinPrice ();
     std::string getCzechBibleVerse ();
+    std::string searchCzechBibleVerses (const std::string& words);
+    // e.g. getVerse ("Genesis", 1, 3)
+    std::string getVerse (const std::string& book, int chapter, int verse);
+    // e.g. getVerses ("Jan 3:16-18; Genesis 1:3"), references are separated by ';'
+    std::string getVerses (const std::string& references);
     std::string getCzechExchangeRate ();
     std::string getCurrentTime ();
     std::string getSunriset ();
+    // Message of a channel job, throws std::runtime_error when it cannot be built
+    std::string getChannelJobMessage (std::uint8_t job);
 
-    RSSFeed feedRootCz;
     std::string getRootcz ();
     std::string parseRSS (const std::string& xmlData);
     int getRandom (int min, int max);
 
+    // Items of this document only, merging them is up to the caller
     RSSFeed parseRSSToStruct (const std::string& xmlData);
 
+    // Remote source of a cached message, the sources are defined in MyDpp.cpp
+    struct DataSource;
+
   private:
+    // Consumer of a body while it downloads, defined in MyDpp.cpp
+    struct BodyStream;
+    // Slash command descriptor, the registration table is defined in MyDpp.cpp
+    struct Command;
+
+    // Queued on sendQueue_, interaction posts go before the scheduled ones; dropped once
+    // shutdown started
+    void postMessage (const dpp::message& msg, bool interaction = false);
+    using ResponseCache = dotname::TtlCache<std::string>;
+    using ResponseLoader = std::function<void (std::function<void (bool, std::string)>)>;
+
+    std::string formatBitcoinPrice (const std::string& body);
+    std::string formatCzechExchangeRate (const std::string& body);
+    // Parses the root.cz feed as it streams in and renders the merged feed at its end
+    std::shared_ptr<BodyStream> streamRootcz ();
+    std::string renderRootcz ();
+    // Loads source on the async client, used for misses and background revalidation
+    ResponseLoader loadWhenFetched (const DataSource& source);
+    // Cached message of source, blocks only on a miss
+    std::string getCached (const DataSource& source);
+    // Replies from the cache or defers the reply until the message is fetched
+    void replyWhenFetched (const dpp::slashcommand_t& event, const DataSource& source);
+    // Time from receiving command until its answer was handed to D++; for a handler that
+    // defers on its own, until it acknowledged
+    void recordLatency (const Command& command, std::chrono::steady_clock::time_point received);
+
+    std::unique_ptr<dotname::HttpClient> httpClient_;
+    std::unique_ptr<dotname::AsyncHttpClient> asyncHttpClient_;
+    std::unique_ptr<ResponseCache> responseCache_;
+    std::unique_ptr<dotname::ValidatorStore> validators_;
+    std::unique_ptr<dotname::FeedStore<RSSItem> > rootczFeed_;
+    std::unique_ptr<dotname::FeedAggregator> feedAggregator_;
+    std::unique_ptr<dotname::ChannelJobs> channelJobs_;
+    // Outlives the cluster, late answers of abandoned requests still reach it
+    std::unique_ptr<dotname::SendQueue> sendQueue_;
+    // Runs every periodic job, stopped first on destruction
+    std::unique_ptr<dotname::Scheduler> scheduler_;
+    // Computes the answers of deferred slash commands, stopped with the scheduler
+    std::unique_ptr<dotname::WorkerPool> commandPool_;
+    std::unique_ptr<dotname::CommandLatency> commandLatency_;
+    std::unique_ptr<dotname::SystemInfo> systemInfo_;
+    std::atomic<std::uint64_t> emojiJob_{ 0 };
+    std::mutex shutdownMutex_;
+    bool isShutdown_ = false;
+    std::thread stopper_;
     std::unique_ptr<dpp::cluster> m_bot;
     std::shared_ptr<dotname::EmojiTools> emojiTools;
     std::shared_ptr<dotname::Sunriset> sunrisetTools;
+    std::unique_ptr<dotname::VerseIndex> verseIndex_;
+    std::unique_ptr<dotname::VerseSearch> verseSearch_;
     std::string emoji;
   };
 
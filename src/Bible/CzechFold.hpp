@@ -0,0 +1,68 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#ifndef CZECHFOLD_HPP
+#define CZECHFOLD_HPP
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace dotname {
+
+  // Diacritics folding shared by the verse search and the book name lookup
+  namespace CzechFold {
+    struct Fold {
+      std::uint32_t codepoint;
+      char letter;
+    };
+
+    // Czech letters with diacritics and their base letter
+    constexpr std::array<Fold, 30> czechFolds = { {
+        { 0xC1, 'a' },  { 0xE1, 'a' },  { 0x10C, 'c' }, { 0x10D, 'c' }, { 0x10E, 'd' },
+        { 0x10F, 'd' }, { 0xC9, 'e' },  { 0xE9, 'e' },  { 0x11A, 'e' }, { 0x11B, 'e' },
+        { 0xCD, 'i' },  { 0xED, 'i' },  { 0x147, 'n' }, { 0x148, 'n' }, { 0xD3, 'o' },
+        { 0xF3, 'o' },  { 0x158, 'r' }, { 0x159, 'r' }, { 0x160, 's' }, { 0x161, 's' },
+        { 0x164, 't' }, { 0x165, 't' }, { 0xDA, 'u' },  { 0xFA, 'u' },  { 0x16E, 'u' },
+        { 0x16F, 'u' }, { 0xDD, 'y' },  { 0xFD, 'y' },  { 0x17D, 'z' }, { 0x17E, 'z' },
+    } };
+
+    // 0 for anything but a Czech letter with diacritics
+    inline char foldCodepoint (std::uint32_t cp) {
+      for (const Fold& fold : czechFolds) {
+        if (fold.codepoint == cp) {
+          return fold.letter;
+        }
+      }
+      return 0;
+    }
+
+    // Decodes one UTF-8 sequence at pos, invalid bytes are returned as they are
+    inline std::uint32_t nextCodepoint (std::string_view text, std::size_t& pos,
+                                        std::size_t& length) {
+      const unsigned char c = static_cast<unsigned char> (text[pos]);
+      length = c < 0x80 ? 1 : (c >> 5) == 0x6 ? 2 : (c >> 4) == 0xE ? 3 : (c >> 3) == 0x1E ? 4 : 1;
+      if (pos + length > text.size ()) {
+        length = 1;
+      }
+      std::uint32_t cp = length == 1 ? c : c & (0x7F >> length);
+      for (std::size_t i = 1; i < length; ++i) {
+        cp = (cp << 6) | (static_cast<unsigned char> (text[pos + i]) & 0x3F);
+      }
+      pos += length;
+      return cp;
+    }
+
+    // Lower case ASCII for latin letters, 0 for anything else
+    inline char foldLetter (std::uint32_t cp) {
+      if ((cp >= 'a' && cp <= 'z') || (cp >= 'A' && cp <= 'Z')) {
+        return static_cast<char> (cp | 0x20);
+      }
+      return foldCodepoint (cp);
+    }
+
+  } // namespace CzechFold
+
+} // namespace dotname
+
+#endif // CZECHFOLD_HPP
@@ -0,0 +1,463 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include "VerseIndex.hpp"
+#include "CzechFold.hpp"
+
+#include <Logger/Logger.hpp>
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+namespace dotname {
+
+  namespace {
+    bool isDigit (char c) {
+      return c >= '0' && c <= '9';
+    }
+
+    // "Genesis 12" -> position of the space before the trailing number
+    std::size_t trailingNumberSeparator (std::string_view line) {
+      std::size_t pos = line.size ();
+      while (pos > 0 && isDigit (line[pos - 1])) {
+        --pos;
+      }
+      if (pos == line.size () || pos < 2 || line[pos - 1] != ' ') {
+        return std::string_view::npos;
+      }
+      return pos - 1;
+    }
+
+    std::uint16_t parseNumber (std::string_view digits) {
+      unsigned value = 0;
+      for (char c : digits) {
+        if (!isDigit (c)) {
+          break;
+        }
+        value = value * 10 + static_cast<unsigned> (c - '0');
+      }
+      return static_cast<std::uint16_t> (value);
+    }
+
+    constexpr char indexMagic[4] = { 'K', 'R', 'I', 'X' };
+
+    std::uint32_t checksum (const char* data, std::size_t size) {
+      uLong crc = crc32 (0L, Z_NULL, 0);
+      // zlib takes uInt lengths
+      while (size > 0) {
+        const uInt chunk = static_cast<uInt> (std::min<std::size_t> (size, 1u << 30));
+        crc = crc32 (crc, reinterpret_cast<const Bytef*> (data), chunk);
+        data += chunk;
+        size -= chunk;
+      }
+      return static_cast<std::uint32_t> (crc);
+    }
+
+    template <typename T>
+    std::uint32_t checksum (std::uint32_t crc, const T* data, std::size_t count) {
+      return static_cast<std::uint32_t> (crc32 (crc, reinterpret_cast<const Bytef*> (data),
+                                                static_cast<uInt> (count * sizeof (T))));
+    }
+  } // namespace
+
+  bool VerseIndex::load (const std::filesystem::path& textPath) {
+    verses_.clear ();
+    chapters_.clear ();
+    books_.clear ();
+    index_.close ();
+    verseData_ = nullptr;
+    chapterData_ = nullptr;
+    bookData_ = nullptr;
+    verseCount_ = chapterCount_ = bookCount_ = 0;
+    fromIndexFile_ = false;
+    bookKeys_.clear ();
+    bookTable_.clear ();
+
+    if (!text_.open (textPath)) {
+      LOG_E_STREAM << "Error: Could not map file " << textPath << std::endl;
+      return false;
+    }
+    if (text_.size () > std::numeric_limits<std::uint32_t>::max ()) {
+      LOG_E_STREAM << "Error: File is too large to be indexed " << textPath << std::endl;
+      text_.close ();
+      return false;
+    }
+
+    const std::uint32_t textCrc = checksum (text_.data (), text_.size ());
+    const std::filesystem::path indexPath = indexPathFor (textPath);
+    if (mapIndexFile (indexPath, textCrc)) {
+      fromIndexFile_ = true;
+      buildBookTable ();
+      LOG_D_STREAM << "Loaded " << verseCount_ << " verses in " << chapterCount_
+                   << " chapters of " << bookCount_ << " books from " << indexPath << std::endl;
+      return true;
+    }
+
+    if (!build ()) {
+      LOG_E_STREAM << "Error: No verses found in " << textPath << std::endl;
+      text_.close ();
+      return false;
+    }
+    useBuiltTables ();
+    buildBookTable ();
+
+    LOG_D_STREAM << "Indexed " << verseCount_ << " verses in " << chapterCount_ << " chapters of "
+                 << bookCount_ << " books" << std::endl;
+
+    // assets may be installed read-only, the in-memory index still serves
+    if (!writeIndexFile (indexPath, textCrc)) {
+      LOG_W_STREAM << "Warning: Could not write verse index " << indexPath << std::endl;
+    }
+    return true;
+  }
+
+  void VerseIndex::useBuiltTables () {
+    verseData_ = verses_.data ();
+    chapterData_ = chapters_.data ();
+    bookData_ = books_.data ();
+    verseCount_ = verses_.size ();
+    chapterCount_ = chapters_.size ();
+    bookCount_ = books_.size ();
+  }
+
+  bool VerseIndex::mapIndexFile (const std::filesystem::path& indexPath, std::uint32_t textCrc) {
+    std::error_code ec;
+    if (!std::filesystem::exists (indexPath, ec) || !index_.open (indexPath)) {
+      return false;
+    }
+
+    IndexHeader header;
+    if (index_.size () < sizeof (header)) {
+      index_.close ();
+      return false;
+    }
+    std::memcpy (&header, index_.data (), sizeof (header));
+
+    const std::size_t payloadSize = header.bookCount * sizeof (BookSpan)
+                                    + header.chapterCount * sizeof (ChapterSpan)
+                                    + header.verseCount * sizeof (VerseSpan);
+    if (std::memcmp (header.magic, indexMagic, sizeof (indexMagic)) != 0
+        || header.version != indexVersion || header.textSize != text_.size ()
+        || header.textCrc != textCrc || header.verseCount == 0
+        || index_.size () != sizeof (header) + payloadSize) {
+      LOG_D_STREAM << "Verse index " << indexPath << " is stale, rebuilding" << std::endl;
+      index_.close ();
+      return false;
+    }
+
+    const char* payload = index_.data () + sizeof (header);
+    if (checksum (payload, payloadSize) != header.payloadCrc) {
+      LOG_W_STREAM << "Warning: Verse index " << indexPath << " is corrupted, rebuilding"
+                   << std::endl;
+      index_.close ();
+      return false;
+    }
+
+    // the mapping is page aligned and every table is a multiple of 4 bytes
+    bookData_ = reinterpret_cast<const BookSpan*> (payload);
+    chapterData_ = reinterpret_cast<const ChapterSpan*> (bookData_ + header.bookCount);
+    verseData_ = reinterpret_cast<const VerseSpan*> (chapterData_ + header.chapterCount);
+    bookCount_ = header.bookCount;
+    chapterCount_ = header.chapterCount;
+    verseCount_ = header.verseCount;
+    return true;
+  }
+
+  bool VerseIndex::writeIndexFile (const std::filesystem::path& indexPath,
+                                   std::uint32_t textCrc) const {
+    IndexHeader header{};
+    std::memcpy (header.magic, indexMagic, sizeof (indexMagic));
+    header.version = indexVersion;
+    header.textSize = text_.size ();
+    header.textCrc = textCrc;
+    header.bookCount = static_cast<std::uint32_t> (books_.size ());
+    header.chapterCount = static_cast<std::uint32_t> (chapters_.size ());
+    header.verseCount = static_cast<std::uint32_t> (verses_.size ());
+
+    std::uint32_t crc = static_cast<std::uint32_t> (crc32 (0L, Z_NULL, 0));
+    crc = checksum (crc, books_.data (), books_.size ());
+    crc = checksum (crc, chapters_.data (), chapters_.size ());
+    crc = checksum (crc, verses_.data (), verses_.size ());
+    header.payloadCrc = crc;
+
+    // written aside and renamed, a concurrent reader never maps a half written file
+    std::filesystem::path tmpPath = indexPath;
+    tmpPath += ".tmp";
+    {
+      std::ofstream file (tmpPath, std::ios::out | std::ios::binary | std::ios::trunc);
+      if (!file.is_open ()) {
+        return false;
+      }
+      file.write (reinterpret_cast<const char*> (&header), sizeof (header));
+      file.write (reinterpret_cast<const char*> (books_.data ()),
+                  static_cast<std::streamsize> (books_.size () * sizeof (BookSpan)));
+      file.write (reinterpret_cast<const char*> (chapters_.data ()),
+                  static_cast<std::streamsize> (chapters_.size () * sizeof (ChapterSpan)));
+      file.write (reinterpret_cast<const char*> (verses_.data ()),
+                  static_cast<std::streamsize> (verses_.size () * sizeof (VerseSpan)));
+      if (!file.good ()) {
+        std::error_code ec;
+        std::filesystem::remove (tmpPath, ec);
+        return false;
+      }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename (tmpPath, indexPath, ec);
+    if (ec) {
+      std::filesystem::remove (tmpPath, ec);
+      return false;
+    }
+    return true;
+  }
+
+  bool VerseIndex::build () {
+    const char* begin = text_.data ();
+    const std::size_t size = text_.size ();
+
+    // ~31k verses, ~1.2k chapters and 66 books for the Kralice text
+    verses_.reserve (size / 100);
+    chapters_.reserve (size / 3000);
+
+    auto lineAt = [&] (std::size_t pos, std::size_t& next) -> std::string_view {
+      const void* nl = std::memchr (begin + pos, '\n', size - pos);
+      std::size_t end = nl ? static_cast<std::size_t> (static_cast<const char*> (nl) - begin)
+                           : size;
+      next = nl ? end + 1 : size;
+      if (end > pos && begin[end - 1] == '\r') {
+        --end;
+      }
+      return std::string_view (begin + pos, end - pos);
+    };
+
+    bool prevEmpty = true;
+    std::size_t pos = 0;
+    while (pos < size) {
+      std::size_t next = 0;
+      std::string_view line = lineAt (pos, next);
+      const std::uint32_t offset = static_cast<std::uint32_t> (pos);
+
+      if (line.empty ()) {
+        prevEmpty = true;
+        pos = next;
+        continue;
+      }
+
+      bool nextEmpty = next >= size;
+      if (!nextEmpty) {
+        std::size_t afterNext = 0;
+        nextEmpty = lineAt (next, afterNext).empty ();
+      }
+
+      const std::size_t separator = trailingNumberSeparator (line);
+      if (prevEmpty && nextEmpty && separator != std::string_view::npos) {
+        // chapter heading
+        std::string_view book = line.substr (0, separator);
+        if (books_.empty () || slice (books_.back ().nameOffset, books_.back ().nameLength) != book) {
+          books_.push_back ({ offset, static_cast<std::uint16_t> (book.size ()),
+                              static_cast<std::uint16_t> (chapters_.size ()), 0, 0 });
+        }
+        ++books_.back ().chapterCount;
+        chapters_.push_back ({ offset, static_cast<std::uint16_t> (line.size ()),
+                               static_cast<std::uint16_t> (books_.size () - 1),
+                               parseNumber (line.substr (separator + 1)), 0,
+                               static_cast<std::uint32_t> (verses_.size ()), 0 });
+      } else if (!chapters_.empty () && isDigit (line.front ())) {
+        verses_.push_back ({ offset, static_cast<std::uint32_t> (line.size ()),
+                             static_cast<std::uint16_t> (chapters_.size () - 1),
+                             parseNumber (line) });
+        ++chapters_.back ().verseCount;
+      }
+
+      prevEmpty = false;
+      pos = next;
+    }
+
+    verses_.shrink_to_fit ();
+    chapters_.shrink_to_fit ();
+    return !verses_.empty ();
+  }
+
+  VerseIndex::Verse VerseIndex::verseAt (std::size_t id) const {
+    const VerseSpan& verse = verseData_[id];
+    const ChapterSpan& chapter = chapterData_[verse.chapter];
+    const BookSpan& book = bookData_[chapter.book];
+    return Verse{ slice (chapter.headingOffset, chapter.headingLength),
+                  slice (book.nameOffset, book.nameLength), slice (verse.offset, verse.length),
+                  chapter.number, verse.number };
+  }
+
+  std::string VerseIndex::bookKey (std::string_view name) {
+    std::string key;
+    key.reserve (name.size ());
+    std::size_t pos = 0;
+    while (pos < name.size ()) {
+      std::size_t length = 0;
+      const std::uint32_t cp = CzechFold::nextCodepoint (name, pos, length);
+      if (char folded = CzechFold::foldLetter (cp)) {
+        key.push_back (folded);
+      } else if (cp < 0x80 && isDigit (static_cast<char> (cp))) {
+        key.push_back (static_cast<char> (cp));
+      }
+    }
+    return key;
+  }
+
+  std::uint32_t VerseIndex::bookHash (std::string_view key, std::uint32_t seed) {
+    std::uint32_t hash = 2166136261u ^ seed;
+    for (char c : key) {
+      hash = (hash ^ static_cast<unsigned char> (c)) * 16777619u;
+    }
+    return hash ^ (hash >> 15);
+  }
+
+  void VerseIndex::buildBookTable () {
+    bookKeys_.clear ();
+    bookTable_.clear ();
+    bookKeys_.reserve (bookCount_);
+    for (std::size_t book = 0; book < bookCount_; ++book) {
+      const BookSpan& span = bookData_[book];
+      bookKeys_.push_back (bookKey (slice (span.nameOffset, span.nameLength)));
+    }
+    if (bookCount_ >= std::numeric_limits<std::uint8_t>::max ()) {
+      return;
+    }
+
+    // 66 books in 512 slots, a collision free seed is usually found within a hundred tries
+    std::vector<std::uint8_t> table (512);
+    const std::uint32_t mask = static_cast<std::uint32_t> (table.size () - 1);
+    for (std::uint32_t seed = 0; seed < (1u << 16); ++seed) {
+      std::fill (table.begin (), table.end (), 0);
+      bool collision = false;
+      for (std::size_t book = 0; book < bookKeys_.size () && !collision; ++book) {
+        std::uint8_t& slot = table[bookHash (bookKeys_[book], seed) & mask];
+        collision = slot != 0;
+        slot = static_cast<std::uint8_t> (book + 1);
+      }
+      if (!collision) {
+        bookTable_ = std::move (table);
+        bookSeed_ = seed;
+        return;
+      }
+    }
+    LOG_W_STREAM << "Warning: No perfect hash for book names, falling back to a scan" << std::endl;
+  }
+
+  std::size_t VerseIndex::findBook (std::string_view name) const {
+    const std::string key = bookKey (name);
+    if (key.empty ()) {
+      return npos;
+    }
+
+    if (!bookTable_.empty ()) {
+      const std::uint32_t mask = static_cast<std::uint32_t> (bookTable_.size () - 1);
+      const std::uint8_t slot = bookTable_[bookHash (key, bookSeed_) & mask];
+      if (slot != 0 && bookKeys_[slot - 1] == key) {
+        return slot - 1;
+      }
+    }
+
+    // abbreviations, only when they name a single book
+    std::size_t found = npos;
+    for (std::size_t book = 0; book < bookKeys_.size (); ++book) {
+      if (bookKeys_[book].compare (0, key.size (), key) == 0) {
+        if (bookKeys_[book].size () == key.size ()) {
+          return book;
+        }
+        if (found != npos) {
+          return npos;
+        }
+        found = book;
+      }
+    }
+    return found;
+  }
+
+  std::size_t VerseIndex::findVerse (std::size_t book, unsigned chapter, unsigned verse) const {
+    if (book >= bookCount_ || chapter == 0 || verse == 0) {
+      return npos;
+    }
+
+    // chapters and verses are numbered densely from 1, the scans only cover irregular texts
+    const BookSpan& bookSpan = bookData_[book];
+    std::size_t chapterId = npos;
+    if (chapter <= bookSpan.chapterCount
+        && chapterData_[bookSpan.firstChapter + chapter - 1].number == chapter) {
+      chapterId = bookSpan.firstChapter + chapter - 1;
+    } else {
+      for (std::size_t i = 0; i < bookSpan.chapterCount; ++i) {
+        if (chapterData_[bookSpan.firstChapter + i].number == chapter) {
+          chapterId = bookSpan.firstChapter + i;
+          break;
+        }
+      }
+    }
+    if (chapterId == npos) {
+      return npos;
+    }
+
+    const ChapterSpan& chapterSpan = chapterData_[chapterId];
+    if (verse <= chapterSpan.verseCount
+        && verseData_[chapterSpan.firstVerse + verse - 1].number == verse) {
+      return chapterSpan.firstVerse + verse - 1;
+    }
+    for (std::size_t i = 0; i < chapterSpan.verseCount; ++i) {
+      if (verseData_[chapterSpan.firstVerse + i].number == verse) {
+        return chapterSpan.firstVerse + i;
+      }
+    }
+    return npos;
+  }
+
+  bool VerseIndex::findReference (std::string_view reference, std::size_t& first,
+                                  std::size_t& count) const {
+    while (!reference.empty () && (reference.back () == ' ' || reference.back () == '.')) {
+      reference.remove_suffix (1);
+    }
+    const std::size_t split = reference.find_last_of (' ');
+    if (split == std::string_view::npos) {
+      return false;
+    }
+    const std::size_t book = findBook (reference.substr (0, split));
+    std::string_view numbers = reference.substr (split + 1);
+    if (book == npos || numbers.empty () || !isDigit (numbers.front ())) {
+      return false;
+    }
+
+    // <chapter>[(:|,)<verse>[-<verse>]]
+    const unsigned chapter = parseNumber (numbers);
+    const std::size_t colon = numbers.find_first_of (":,");
+    if (colon == std::string_view::npos) {
+      first = findVerse (book, chapter, 1);
+      if (first == npos) {
+        return false;
+      }
+      count = chapterData_[verseData_[first].chapter].verseCount;
+      return true;
+    }
+
+    const unsigned from = parseNumber (numbers.substr (colon + 1));
+    first = findVerse (book, chapter, from);
+    if (first == npos) {
+      return false;
+    }
+    count = 1;
+    const std::size_t dash = numbers.find ('-', colon);
+    if (dash != std::string_view::npos) {
+      const unsigned to = parseNumber (numbers.substr (dash + 1));
+      if (to < from) {
+        return false;
+      }
+      // ranges past the end of the chapter are cut at its last verse
+      const ChapterSpan& chapterSpan = chapterData_[verseData_[first].chapter];
+      const std::size_t last = chapterSpan.firstVerse + chapterSpan.verseCount - 1;
+      count = std::min<std::size_t> (first + (to - from), last) - first + 1;
+    }
+    return true;
+  }
+
+} // namespace dotname
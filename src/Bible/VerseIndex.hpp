@@ -0,0 +1,167 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#ifndef VERSEINDEX_HPP
+#define VERSEINDEX_HPP
+
+#include <Utils/MappedFile.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace dotname {
+
+  // Offset table over the Kralice Bible text (assets/kralicky.txt).
+  //
+  // The text is mapped once and every verse is addressed by its byte span,
+  // so lookups return views into the mapping without copying anything.
+  //
+  // Expected layout of the text file:
+  //   <Book name> <chapter>
+  //   <empty line>
+  //   <verse> <text>
+  //   ...
+  //   <empty line>
+  //
+  // The span tables are persisted next to the text (kralicky.idx) and later
+  // loads map that file instead of scanning the text again. The index is
+  // bound to the text by size and CRC32, a stale or foreign index is rebuilt.
+  class VerseIndex {
+  public:
+    struct Verse {
+      std::string_view heading; // "Genesis 1"
+      std::string_view book;    // "Genesis"
+      std::string_view text;    // "1 Na počátku stvořil Bůh nebe a zemi."
+      std::uint16_t chapter = 0;
+      std::uint16_t number = 0;
+    };
+
+    VerseIndex () = default;
+    ~VerseIndex () = default;
+    VerseIndex (const VerseIndex&) = delete;
+    VerseIndex& operator= (const VerseIndex&) = delete;
+
+    static constexpr std::uint32_t indexVersion = 1;
+    static constexpr std::size_t npos = static_cast<std::size_t> (-1);
+
+    static std::filesystem::path indexPathFor (const std::filesystem::path& textPath) {
+      return std::filesystem::path (textPath).replace_extension (".idx");
+    }
+
+    // Maps the text and its persisted index, rebuilds (and rewrites) the index when stale
+    bool load (const std::filesystem::path& textPath);
+    bool isLoaded () const {
+      return verseCount_ != 0;
+    }
+    // True when the last load was served from the persisted index
+    bool isFromIndexFile () const {
+      return fromIndexFile_;
+    }
+
+    std::size_t verseCount () const {
+      return verseCount_;
+    }
+    std::size_t chapterCount () const {
+      return chapterCount_;
+    }
+    std::size_t bookCount () const {
+      return bookCount_;
+    }
+
+    // id in range <0, verseCount ())
+    Verse verseAt (std::size_t id) const;
+
+    // Book id by name, case, diacritics and spaces are ignored ("1 Samuelova" == "1samuelova")
+    // and a unique prefix is accepted ("Gen"), npos when unknown
+    std::size_t findBook (std::string_view name) const;
+    // Verse id of chapter:verse of a book, npos when out of range
+    std::size_t findVerse (std::size_t book, unsigned chapter, unsigned verse) const;
+    // "Jan 3:16-18", "Genesis 1,3" or a whole chapter "Jan 3" as a run of verse ids
+    bool findReference (std::string_view reference, std::size_t& first, std::size_t& count) const;
+
+  private:
+    struct VerseSpan {
+      std::uint32_t offset;
+      std::uint32_t length;
+      std::uint16_t chapter; // index into chapters_
+      std::uint16_t number;
+    };
+
+    // padding is spelled out, the spans are written to the index file as they are
+    struct ChapterSpan {
+      std::uint32_t headingOffset;
+      std::uint16_t headingLength;
+      std::uint16_t book; // index into books_
+      std::uint16_t number;
+      std::uint16_t reserved;
+      std::uint32_t firstVerse;
+      std::uint32_t verseCount;
+    };
+
+    struct BookSpan {
+      std::uint32_t nameOffset;
+      std::uint16_t nameLength;
+      std::uint16_t firstChapter;
+      std::uint16_t chapterCount;
+      std::uint16_t reserved;
+    };
+
+    // kralicky.idx: header followed by books, chapters and verses tables
+    struct IndexHeader {
+      char magic[4];
+      std::uint32_t version;
+      std::uint64_t textSize;
+      std::uint32_t textCrc;
+      std::uint32_t payloadCrc;
+      std::uint32_t bookCount;
+      std::uint32_t chapterCount;
+      std::uint32_t verseCount;
+      std::uint32_t reserved;
+    };
+
+    static_assert (sizeof (VerseSpan) == 12 && sizeof (ChapterSpan) == 20
+                       && sizeof (BookSpan) == 12 && sizeof (IndexHeader) == 40,
+                   "index file layout changed, bump indexVersion");
+    static_assert (std::is_trivially_copyable<IndexHeader>::value, "");
+
+    bool build ();
+    void buildBookTable ();
+    static std::string bookKey (std::string_view name);
+    static std::uint32_t bookHash (std::string_view key, std::uint32_t seed);
+    bool mapIndexFile (const std::filesystem::path& indexPath, std::uint32_t textCrc);
+    bool writeIndexFile (const std::filesystem::path& indexPath, std::uint32_t textCrc) const;
+    void useBuiltTables ();
+    std::string_view slice (std::uint32_t offset, std::uint32_t length) const {
+      return std::string_view (text_.data () + offset, length);
+    }
+
+    DotNameUtils::FileIO::MappedFile text_;
+    DotNameUtils::FileIO::MappedFile index_;
+
+    // tables built from the text, empty when served from index_
+    std::vector<VerseSpan> verses_;
+    std::vector<ChapterSpan> chapters_;
+    std::vector<BookSpan> books_;
+
+    // active tables, point either into the vectors above or into index_
+    const VerseSpan* verseData_ = nullptr;
+    const ChapterSpan* chapterData_ = nullptr;
+    const BookSpan* bookData_ = nullptr;
+    std::size_t verseCount_ = 0;
+    std::size_t chapterCount_ = 0;
+    std::size_t bookCount_ = 0;
+    bool fromIndexFile_ = false;
+
+    // folded book names and their collision free hash table (book id + 1, 0 for empty slots)
+    std::vector<std::string> bookKeys_;
+    std::vector<std::uint8_t> bookTable_;
+    std::uint32_t bookSeed_ = 0;
+  };
+
+} // namespace dotname
+
+#endif // VERSEINDEX_HPP
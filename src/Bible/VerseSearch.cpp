@@ -0,0 +1,217 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include "VerseSearch.hpp"
+#include "CzechFold.hpp"
+#include "VerseIndex.hpp"
+
+#include <Logger/Logger.hpp>
+
+#include <algorithm>
+#include <array>
+
+namespace dotname {
+
+  namespace {
+    void putVarint (std::vector<std::uint8_t>& out, std::uint32_t value) {
+      while (value >= 0x80) {
+        out.push_back (static_cast<std::uint8_t> (value | 0x80));
+        value >>= 7;
+      }
+      out.push_back (static_cast<std::uint8_t> (value));
+    }
+
+    std::uint32_t getVarint (const std::uint8_t*& in) {
+      std::uint32_t value = 0;
+      for (int shift = 0;; shift += 7) {
+        const std::uint8_t byte = *in++;
+        value |= static_cast<std::uint32_t> (byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+          return value;
+        }
+      }
+    }
+  } // namespace
+
+  // Forward-only reader of one posting list, seeks gallop over the skip table
+  class VerseSearch::Cursor {
+  public:
+    Cursor (const VerseSearch& search, const Term& term)
+        : search_ (search), skips_ (search.skips_.data () + term.firstSkip), count_ (term.count),
+          blocks_ ((term.count + blockSize - 1) / blockSize) {
+    }
+
+    std::size_t decode (std::size_t block, std::uint32_t* out) const {
+      const std::size_t n = std::min (blockSize, count_ - block * blockSize);
+      const std::uint8_t* in = search_.postings_.data () + skips_[block].offset;
+      std::uint32_t id = skips_[block].firstId;
+      out[0] = id;
+      for (std::size_t i = 1; i < n; ++i) {
+        id += getVarint (in);
+        out[i] = id;
+      }
+      return n;
+    }
+
+    void decodeAll (std::vector<std::uint32_t>& out) const {
+      out.resize (count_);
+      for (std::size_t block = 0; block < blocks_; ++block) {
+        decode (block, out.data () + block * blockSize);
+      }
+    }
+
+    // ids must be sought in ascending order
+    bool contains (std::uint32_t id) {
+      if (skips_[block_].firstId > id) {
+        return false;
+      }
+      // exponential probe for the last block starting at or before id, then binary search
+      std::size_t step = 1;
+      while (block_ + step < blocks_ && skips_[block_ + step].firstId <= id) {
+        step <<= 1;
+      }
+      std::size_t lo = block_ + (step >> 1);
+      std::size_t hi = std::min (block_ + step, blocks_);
+      while (hi - lo > 1) {
+        const std::size_t mid = lo + (hi - lo) / 2;
+        (skips_[mid].firstId <= id ? lo : hi) = mid;
+      }
+      if (lo != block_ || !decoded_) {
+        block_ = lo;
+        size_ = decode (block_, buffer_.data ());
+        pos_ = 0;
+        decoded_ = true;
+      }
+      while (pos_ < size_ && buffer_[pos_] < id) {
+        ++pos_;
+      }
+      return pos_ < size_ && buffer_[pos_] == id;
+    }
+
+  private:
+    const VerseSearch& search_;
+    const Skip* skips_;
+    std::size_t count_;
+    std::size_t blocks_;
+    std::size_t block_ = 0;
+    bool decoded_ = false;
+    std::array<std::uint32_t, blockSize> buffer_;
+    std::size_t size_ = 0;
+    std::size_t pos_ = 0;
+  };
+
+  void VerseSearch::tokenize (std::string_view text, std::vector<std::string>& tokens) {
+    std::string token;
+    auto flush = [&] () {
+      if (!token.empty ()) {
+        tokens.push_back (token);
+        token.clear ();
+      }
+    };
+
+    std::size_t pos = 0;
+    while (pos < text.size ()) {
+      std::size_t length = 0;
+      const std::size_t start = pos;
+      const std::uint32_t cp = CzechFold::nextCodepoint (text, pos, length);
+      if (char folded = CzechFold::foldLetter (cp)) {
+        token.push_back (folded);
+      } else if (cp >= 0xC0 && cp <= 0x24F && cp != 0xD7 && cp != 0xF7) {
+        // other Latin letters are kept as they are
+        token.append (text.data () + start, length);
+      } else {
+        flush ();
+      }
+    }
+    flush ();
+  }
+
+  bool VerseSearch::build (const VerseIndex& index) {
+    terms_.clear ();
+    skips_.clear ();
+    postings_.clear ();
+
+    std::unordered_map<std::string, std::vector<std::uint32_t> > lists;
+    lists.reserve (1 << 15);
+    std::vector<std::string> tokens;
+    for (std::size_t id = 0; id < index.verseCount (); ++id) {
+      tokens.clear ();
+      tokenize (index.verseAt (id).text, tokens);
+      for (std::string& token : tokens) {
+        std::vector<std::uint32_t>& list = lists[std::move (token)];
+        if (list.empty () || list.back () != id) {
+          list.push_back (static_cast<std::uint32_t> (id));
+        }
+      }
+    }
+
+    terms_.reserve (lists.size ());
+    postings_.reserve (index.verseCount () * 12);
+    for (auto& [word, list] : lists) {
+      terms_.emplace (word, Term{ static_cast<std::uint32_t> (skips_.size ()),
+                                  static_cast<std::uint32_t> (list.size ()) });
+      for (std::size_t i = 0; i < list.size (); ++i) {
+        if (i % blockSize == 0) {
+          skips_.push_back ({ list[i], static_cast<std::uint32_t> (postings_.size ()) });
+        } else {
+          putVarint (postings_, list[i] - list[i - 1]);
+        }
+      }
+    }
+    skips_.shrink_to_fit ();
+    postings_.shrink_to_fit ();
+
+    LOG_D_STREAM << "Indexed " << terms_.size () << " words, " << postings_.size ()
+                 << " bytes of postings" << std::endl;
+    return !terms_.empty ();
+  }
+
+  std::vector<std::uint32_t> VerseSearch::find (std::string_view query, std::size_t limit,
+                                                std::size_t* total) const {
+    std::vector<std::uint32_t> result;
+    if (total) {
+      *total = 0;
+    }
+
+    std::vector<std::string> words;
+    tokenize (query, words);
+    std::vector<const Term*> matched;
+    matched.reserve (words.size ());
+    for (const std::string& word : words) {
+      auto it = terms_.find (word);
+      if (it == terms_.end ()) {
+        return result;
+      }
+      matched.push_back (&it->second);
+    }
+    if (matched.empty ()) {
+      return result;
+    }
+
+    // the shortest list drives the intersection, longer ones are only probed
+    std::sort (matched.begin (), matched.end (),
+               [] (const Term* a, const Term* b) { return a->count < b->count; });
+    matched.erase (std::unique (matched.begin (), matched.end ()), matched.end ());
+
+    Cursor (*this, *matched.front ()).decodeAll (result);
+    for (std::size_t i = 1; i < matched.size () && !result.empty (); ++i) {
+      Cursor cursor (*this, *matched[i]);
+      std::size_t kept = 0;
+      for (std::uint32_t id : result) {
+        if (cursor.contains (id)) {
+          result[kept++] = id;
+        }
+      }
+      result.resize (kept);
+    }
+
+    if (total) {
+      *total = result.size ();
+    }
+    if (result.size () > limit) {
+      result.resize (limit);
+    }
+    return result;
+  }
+
+} // namespace dotname
@@ -0,0 +1,68 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#ifndef VERSESEARCH_HPP
+#define VERSESEARCH_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace dotname {
+
+  class VerseIndex;
+
+  // Inverted index over the verses of a VerseIndex.
+  //
+  // Words are folded to lower case ASCII ("Počátku" -> "pocatku"), so queries
+  // match with or without diacritics. Every word maps to a posting list of
+  // verse ids, delta + varint encoded in blocks with a skip table, which lets
+  // multi-word queries gallop over the longer lists instead of decoding them.
+  class VerseSearch {
+  public:
+    static constexpr std::size_t blockSize = 64;
+
+    VerseSearch () = default;
+    VerseSearch (const VerseSearch&) = delete;
+    VerseSearch& operator= (const VerseSearch&) = delete;
+
+    // Verse ids stay valid as long as the index itself
+    bool build (const VerseIndex& index);
+    bool isBuilt () const {
+      return !terms_.empty ();
+    }
+    std::size_t termCount () const {
+      return terms_.size ();
+    }
+
+    // Ids of verses containing all words of the query, ascending, at most limit of them.
+    // total receives the number of all matches when given.
+    std::vector<std::uint32_t> find (std::string_view query, std::size_t limit,
+                                     std::size_t* total = nullptr) const;
+
+    // Splits text into folded words, digits and punctuation separate them
+    static void tokenize (std::string_view text, std::vector<std::string>& tokens);
+
+  private:
+    struct Skip {
+      std::uint32_t firstId;
+      std::uint32_t offset; // into postings_, deltas of the ids following firstId
+    };
+
+    struct Term {
+      std::uint32_t firstSkip; // into skips_
+      std::uint32_t count;
+    };
+
+    class Cursor;
+
+    std::unordered_map<std::string, Term> terms_;
+    std::vector<Skip> skips_;
+    std::vector<std::uint8_t> postings_;
+  };
+
+} // namespace dotname
+
+#endif // VERSESEARCH_HPP
@@ -0,0 +1,143 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#ifndef TTLCACHE_HPP
+#define TTLCACHE_HPP
+
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace dotname {
+
+  // Thread safe TTL cache for values produced by slow (remote) loaders.
+  //
+  // - a value younger than ttl is served as it is
+  // - a value younger than ttl + stale is served immediately while one
+  //   background load refreshes it (stale-while-revalidate)
+  // - concurrent misses of one key share a single in-flight load
+  // - when a load fails, waiters get the last known value, however old
+  template <typename Value> class TtlCache {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Policy {
+      Clock::duration ttl;
+      Clock::duration stale;
+    };
+
+    // Loaders report through complete (ok, value), from any thread
+    using Complete = std::function<void (bool, Value)>;
+    using Loader = std::function<void (Complete)>;
+    // nullptr when nothing could be loaded
+    using Done = std::function<void (const Value*)>;
+
+    TtlCache () = default;
+    TtlCache (const TtlCache&) = delete;
+    TtlCache& operator= (const TtlCache&) = delete;
+
+    // Serves a fresh or acceptably stale value into out, false when the caller has to wait
+    bool lookup (const std::string& key, const Policy& policy, const Loader& load, Value& out) {
+      std::unique_lock<std::mutex> lock (mutex_);
+      auto it = entries_.find (key);
+      if (it == entries_.end () || !it->second.hasValue) {
+        return false;
+      }
+      Entry& entry = it->second;
+      const Clock::duration age = Clock::now () - entry.loadedAt;
+      if (age >= policy.ttl + policy.stale) {
+        return false;
+      }
+      out = entry.value;
+      if (age >= policy.ttl && !entry.loading) {
+        entry.loading = true;
+        lock.unlock ();
+        startLoad (key, load);
+      }
+      return true;
+    }
+
+    // Calls done with the cached value or, after a miss, with the loaded one
+    void fetch (const std::string& key, const Policy& policy, const Loader& load, Done done) {
+      Value value;
+      if (lookup (key, policy, load, value)) {
+        done (&value);
+        return;
+      }
+
+      bool start = false;
+      {
+        std::lock_guard<std::mutex> lock (mutex_);
+        Entry& entry = entries_[key];
+        entry.waiters.push_back (std::move (done));
+        start = !entry.loading;
+        entry.loading = true;
+      }
+      if (start) {
+        startLoad (key, load);
+      }
+    }
+
+    // Last known value regardless of its age, e.g. to serve after an upstream 304
+    bool peek (const std::string& key, Value& out) const {
+      std::lock_guard<std::mutex> lock (mutex_);
+      auto it = entries_.find (key);
+      if (it == entries_.end () || !it->second.hasValue) {
+        return false;
+      }
+      out = it->second.value;
+      return true;
+    }
+
+  private:
+    struct Entry {
+      Value value{};
+      bool hasValue = false;
+      bool loading = false;
+      Clock::time_point loadedAt;
+      std::vector<Done> waiters;
+    };
+
+    void startLoad (const std::string& key, const Loader& load) {
+      try {
+        load ([this, key] (bool ok, Value value) { complete (key, ok, std::move (value)); });
+      } catch (...) {
+        complete (key, false, Value{});
+      }
+    }
+
+    void complete (const std::string& key, bool ok, Value value) {
+      std::vector<Done> waiters;
+      Value served{};
+      bool hasValue = false;
+      {
+        std::lock_guard<std::mutex> lock (mutex_);
+        Entry& entry = entries_[key];
+        if (ok) {
+          entry.value = std::move (value);
+          entry.hasValue = true;
+          entry.loadedAt = Clock::now ();
+        }
+        entry.loading = false;
+        waiters.swap (entry.waiters);
+        hasValue = entry.hasValue;
+        if (hasValue && !waiters.empty ()) {
+          served = entry.value;
+        }
+      }
+      for (Done& done : waiters) {
+        done (hasValue ? &served : nullptr);
+      }
+    }
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+  };
+
+} // namespace dotname
+
+#endif // TTLCACHE_HPP
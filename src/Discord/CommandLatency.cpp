@@ -0,0 +1,72 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include "CommandLatency.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace dotname {
+
+  void CommandLatency::record (std::string_view command, Clock::duration latency) {
+    const auto micros = std::max (std::chrono::duration_cast<std::chrono::microseconds> (latency),
+                                  std::chrono::microseconds (0));
+    std::size_t bucket = 0;
+    while (bucket < bucketCount - 1
+           && static_cast<std::uint64_t> (micros.count ()) >= (std::uint64_t (1) << bucket)) {
+      ++bucket;
+    }
+
+    std::lock_guard<std::mutex> lock (mutex_);
+    auto it = commands_.find (command);
+    if (it == commands_.end ()) {
+      it = commands_.emplace (std::string (command), Histogram ()).first;
+    }
+    Histogram& histogram = it->second;
+    ++histogram.buckets[bucket];
+    ++histogram.count;
+    histogram.max = std::max (histogram.max, micros);
+  }
+
+  CommandLatency::Summary CommandLatency::summary (std::string_view command) const {
+    std::lock_guard<std::mutex> lock (mutex_);
+    auto it = commands_.find (command);
+    return it == commands_.end () ? Summary () : it->second.summary ();
+  }
+
+  std::vector<std::pair<std::string, CommandLatency::Summary> >
+  CommandLatency::summaries () const {
+    std::vector<std::pair<std::string, Summary> > all;
+    std::lock_guard<std::mutex> lock (mutex_);
+    for (const auto& [command, histogram] : commands_) {
+      all.emplace_back (command, histogram.summary ());
+    }
+    return all;
+  }
+
+  std::chrono::microseconds CommandLatency::Histogram::percentile (double fraction) const {
+    // the rank-th smallest sample, 1-based
+    const auto rank = std::max<std::uint64_t> (
+        1, static_cast<std::uint64_t> (std::ceil (fraction * static_cast<double> (count))));
+    std::uint64_t seen = 0;
+    for (std::size_t bucket = 0; bucket < bucketCount; ++bucket) {
+      seen += buckets[bucket];
+      if (seen >= rank) {
+        return std::min (std::chrono::microseconds (std::int64_t (1) << bucket), max);
+      }
+    }
+    return max;
+  }
+
+  CommandLatency::Summary CommandLatency::Histogram::summary () const {
+    Summary summary;
+    summary.count = count;
+    summary.max = max;
+    if (count != 0) {
+      summary.p50 = percentile (0.50);
+      summary.p99 = percentile (0.99);
+    }
+    return summary;
+  }
+
+} // namespace dotname
@@ -0,0 +1,62 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#ifndef COMMANDLATENCY_HPP
+#define COMMANDLATENCY_HPP
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace dotname {
+
+  // Latency of slash command answers, a histogram per command.
+  //
+  // Bucket b counts latencies below 2^b microseconds that did not fit bucket
+  // b - 1, so a percentile is exact to a factor of two and recording is a
+  // few instructions under a mutex whatever the number of samples. Thread safe.
+  class CommandLatency {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Summary {
+      std::uint64_t count = 0;
+      // upper bounds of the buckets holding the percentiles, never above max
+      std::chrono::microseconds p50{ 0 };
+      std::chrono::microseconds p99{ 0 };
+      std::chrono::microseconds max{ 0 };
+    };
+
+    void record (std::string_view command, Clock::duration latency);
+    // Zero count for a command never recorded
+    Summary summary (std::string_view command) const;
+    // Every recorded command by name
+    std::vector<std::pair<std::string, Summary> > summaries () const;
+
+  private:
+    static constexpr std::size_t bucketCount = 40;
+
+    struct Histogram {
+      std::array<std::uint64_t, bucketCount> buckets{};
+      std::uint64_t count = 0;
+      std::chrono::microseconds max{ 0 };
+
+      std::chrono::microseconds percentile (double fraction) const;
+      Summary summary () const;
+    };
+
+    mutable std::mutex mutex_;
+    std::map<std::string, Histogram, std::less<> > commands_;
+  };
+
+} // namespace dotname
+
+#endif // COMMANDLATENCY_HPP
@@ -0,0 +1,217 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include "SendQueue.hpp"
+
+#include <Logger/Logger.hpp>
+
+#include <utility>
+
+namespace dotname {
+
+  namespace {
+    // a message rate limited this many times is dropped
+    constexpr int maxAttempts = 3;
+    // Retry-After when a 429 came without one
+    constexpr double defaultRetryAfter = 1.0;
+  } // namespace
+
+  SendQueue::SendQueue (Send send, std::size_t maxMessageSize, double globalPerSecond)
+      : send_ (std::move (send)), maxMessageSize_ (maxMessageSize),
+        global_ (globalPerSecond, globalPerSecond) {
+    thread_ = std::thread (&SendQueue::run, this);
+  }
+
+  SendQueue::~SendQueue () {
+    shutdown (std::chrono::milliseconds::zero ());
+  }
+
+  bool SendQueue::push (Channel channel, std::string content, Lane lane) {
+    if (!pending_.enter ()) {
+      return false;
+    }
+    const std::size_t index = static_cast<std::size_t> (lane);
+    bool merged = false;
+    {
+      std::lock_guard<std::mutex> lock (mutex_);
+      Route& route = routes_[channel];
+      std::deque<Message>& queue = route.lanes[index];
+      // the newest waiting message of the channel takes this one while it fits
+      if (!queue.empty () && queue.back ().attempts == 0) {
+        std::string& last = queue.back ().content;
+        const bool separate = !last.empty () && last.back () != '\n';
+        if (last.size () + separate + content.size () <= maxMessageSize_) {
+          if (separate) {
+            last += '\n';
+          }
+          last += content;
+          merged = true;
+          ++stats_.coalesced;
+        }
+      }
+      if (!merged) {
+        queue.push_back (Message{ std::move (content), 0 });
+        markReady (channel, route, index);
+      }
+    }
+    if (merged) {
+      pending_.leave ();
+    } else {
+      wake_.notify_one ();
+    }
+    return true;
+  }
+
+  bool SendQueue::shutdown (std::chrono::milliseconds timeout) {
+    std::lock_guard<std::mutex> once (shutdownMutex_);
+    const bool drained = pending_.drain (timeout);
+    {
+      std::lock_guard<std::mutex> lock (mutex_);
+      stopping_ = true;
+    }
+    wake_.notify_all ();
+    if (thread_.joinable ()) {
+      thread_.join ();
+    }
+    return drained;
+  }
+
+  SendQueue::Stats SendQueue::stats () const {
+    std::lock_guard<std::mutex> lock (mutex_);
+    return stats_;
+  }
+
+  void SendQueue::markReady (Channel channel, Route& route, std::size_t lane) {
+    if (!route.ready[lane]) {
+      route.ready[lane] = true;
+      ready_[lane].push_back (channel);
+    }
+  }
+
+  bool SendQueue::pick (Clock::time_point now, Channel& channel, std::size_t& lane,
+                        Clock::time_point& wakeAt) {
+    for (std::size_t l = 0; l < laneCount; ++l) {
+      std::deque<Channel>& ready = ready_[l];
+      for (std::size_t n = ready.size (); n > 0; --n) {
+        const Channel candidate = ready.front ();
+        ready.pop_front ();
+        auto it = routes_.find (candidate);
+        Route& route = it->second;
+        if (route.lanes[l].empty ()) {
+          route.ready[l] = false;
+          // a route in no ready list and past its reset has nothing left to remember
+          if (route.idle () && !route.ready[0] && !route.ready[1] && now >= route.resetAt) {
+            routes_.erase (it);
+          }
+          continue;
+        }
+        // round robin, the route waits behind the others whether it is sent or not
+        ready.push_back (candidate);
+        if (route.inFlight) {
+          continue; // its answer wakes the sender
+        }
+        if (route.remaining <= 0 && now < route.resetAt) {
+          wakeAt = std::min (wakeAt, route.resetAt);
+          continue;
+        }
+        channel = candidate;
+        lane = l;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void SendQueue::run () {
+    std::unique_lock<std::mutex> lock (mutex_);
+    while (!stopping_) {
+      const Clock::time_point now = Clock::now ();
+      Clock::time_point wakeAt = Clock::time_point::max ();
+      Channel channel = 0;
+      std::size_t lane = 0;
+      Clock::duration wait{};
+      if (now < globalBlockedUntil_) {
+        wakeAt = globalBlockedUntil_;
+      } else if (pick (now, channel, lane, wakeAt)) {
+        if (global_.take (now, wait)) {
+          Route& route = routes_[channel];
+          Message message = std::move (route.lanes[lane].front ());
+          route.lanes[lane].pop_front ();
+          route.inFlight = true;
+          route.remaining = std::max (route.remaining - 1, 0);
+          ++message.attempts;
+
+          lock.unlock ();
+          const std::string& content = message.content;
+          send_ (channel, content,
+                 [this, channel, lane, message] (const Answer& answer) {
+                   answered (channel, lane, message, answer);
+                 });
+          lock.lock ();
+          continue;
+        }
+        wakeAt = now + wait;
+      }
+
+      if (wakeAt == Clock::time_point::max ()) {
+        wake_.wait (lock);
+      } else {
+        wake_.wait_until (lock, wakeAt);
+      }
+    }
+  }
+
+  void SendQueue::answered (Channel channel, std::size_t lane, Message message,
+                            const Answer& answer) {
+    bool done = true;
+    {
+      std::lock_guard<std::mutex> lock (mutex_);
+      const Clock::time_point now = Clock::now ();
+      // a route is never forgotten while in flight
+      Route& route = routes_[channel];
+      route.inFlight = false;
+      if (answer.remaining >= 0) {
+        route.remaining = answer.remaining;
+      }
+      if (answer.resetAfter >= 0.0) {
+        route.resetAt = now
+                        + std::chrono::duration_cast<Clock::duration> (
+                            std::chrono::duration<double> (answer.resetAfter));
+      }
+
+      if (answer.status == 429) {
+        ++stats_.rateLimited;
+        const Clock::time_point retryAt
+            = now
+              + std::chrono::duration_cast<Clock::duration> (std::chrono::duration<double> (
+                  answer.retryAfter >= 0.0 ? answer.retryAfter : defaultRetryAfter));
+        if (answer.global) {
+          globalBlockedUntil_ = std::max (globalBlockedUntil_, retryAt);
+        } else {
+          route.remaining = 0;
+          route.resetAt = std::max (route.resetAt, retryAt);
+        }
+        if (message.attempts < maxAttempts && !stopping_) {
+          route.lanes[lane].push_front (std::move (message));
+          markReady (channel, route, lane);
+          done = false;
+        } else {
+          ++stats_.failed;
+          LOG_E_STREAM << "Error: Message to " << channel << " dropped, rate limited "
+                       << message.attempts << " times" << std::endl;
+        }
+      } else if (answer.status >= 200 && answer.status < 300) {
+        ++stats_.sent;
+      } else {
+        ++stats_.failed;
+        LOG_E_STREAM << "Error: Message to " << channel << " failed with HTTP "
+                     << answer.status << std::endl;
+      }
+    }
+    wake_.notify_one ();
+    if (done) {
+      pending_.leave ();
+    }
+  }
+
+} // namespace dotname
@@ -0,0 +1,154 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#ifndef SENDQUEUE_HPP
+#define SENDQUEUE_HPP
+
+#include <Scheduler/InFlight.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace dotname {
+
+  // Classic token bucket, not thread safe.
+  class TokenBucket {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    TokenBucket (double capacity, double perSecond)
+        : capacity_ (capacity), perSecond_ (perSecond), tokens_ (capacity) {
+    }
+
+    // Takes a token, or returns false and sets wait to the time until one refills
+    bool take (Clock::time_point now, Clock::duration& wait) {
+      if (refilled_ != Clock::time_point{}) {
+        const double elapsed = std::chrono::duration<double> (now - refilled_).count ();
+        tokens_ = std::min (capacity_, tokens_ + elapsed * perSecond_);
+      }
+      refilled_ = now;
+      if (tokens_ >= 1.0) {
+        tokens_ -= 1.0;
+        return true;
+      }
+      wait = std::chrono::duration_cast<Clock::duration> (
+          std::chrono::duration<double> ((1.0 - tokens_) / perSecond_));
+      return false;
+    }
+
+  private:
+    const double capacity_;
+    const double perSecond_;
+    double tokens_;
+    Clock::time_point refilled_{};
+  };
+
+  // Outbound Discord channel messages, paced by the rate limits Discord reports.
+  //
+  // Every channel is a route with its own bucket, refilled from the
+  // X-RateLimit-Remaining / Reset-After of its last answer; a route has one
+  // request in flight at a time so that those stay accurate. A 429 blocks the
+  // route, or every route when it is global, for its Retry-After and the
+  // message goes first again. The Interaction lane is served before the
+  // Scheduled one, and messages queued for the same channel and lane are
+  // joined as long as they fit one Discord message. One thread sends, answers
+  // may arrive on any thread. Thread safe.
+  class SendQueue {
+  public:
+    using Channel = std::uint64_t;
+    using Clock = std::chrono::steady_clock;
+
+    enum class Lane { Interaction, Scheduled };
+    static constexpr std::size_t laneCount = 2;
+
+    // What Discord answered, rate limit fields are negative when their header was missing
+    struct Answer {
+      int status = 0;
+      int remaining = -1;
+      double resetAfter = -1.0;
+      double retryAfter = -1.0;
+      bool global = false;
+    };
+    using Answered = std::function<void (const Answer& answer)>;
+    // Sends content to channel and calls answered exactly once, on any thread
+    using Send
+        = std::function<void (Channel channel, const std::string& content, Answered answered)>;
+
+    explicit SendQueue (Send send, std::size_t maxMessageSize = 2000,
+                        double globalPerSecond = 50.0);
+    // Unsent messages are dropped
+    ~SendQueue ();
+    SendQueue (const SendQueue&) = delete;
+    SendQueue& operator= (const SendQueue&) = delete;
+
+    // False once shutdown started
+    bool push (Channel channel, std::string content, Lane lane = Lane::Scheduled);
+    // Refuses new messages, sends what is queued within timeout and stops; false when
+    // some were dropped or not answered
+    bool shutdown (std::chrono::milliseconds timeout);
+
+    struct Stats {
+      std::size_t sent = 0;
+      std::size_t coalesced = 0;
+      std::size_t rateLimited = 0;
+      std::size_t failed = 0;
+    };
+    Stats stats () const;
+    // Messages pushed and not answered yet
+    std::size_t pending () const {
+      return pending_.count ();
+    }
+
+  private:
+    struct Message {
+      std::string content;
+      int attempts = 0;
+    };
+    struct Route {
+      std::deque<Message> lanes[laneCount];
+      bool ready[laneCount] = { false, false };
+      bool inFlight = false;
+      // unknown until the first answer, then what Discord reported
+      int remaining = 1;
+      Clock::time_point resetAt{};
+
+      bool idle () const {
+        return !inFlight && lanes[0].empty () && lanes[1].empty ();
+      }
+    };
+
+    void run ();
+    bool pick (Clock::time_point now, Channel& channel, std::size_t& lane,
+               Clock::time_point& wakeAt);
+    void answered (Channel channel, std::size_t lane, Message message, const Answer& answer);
+    void markReady (Channel channel, Route& route, std::size_t lane);
+
+    const Send send_;
+    const std::size_t maxMessageSize_;
+    InFlight pending_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stopping_ = false;
+    TokenBucket global_;
+    Clock::time_point globalBlockedUntil_{};
+    std::unordered_map<Channel, Route> routes_;
+    // routes with messages in a lane, served round robin
+    std::deque<Channel> ready_[laneCount];
+    Stats stats_;
+    std::mutex shutdownMutex_;
+    std::thread thread_;
+  };
+
+} // namespace dotname
+
+#endif // SENDQUEUE_HPP
@@ -0,0 +1,319 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include "AsyncHttpClient.hpp"
+
+#include <Logger/Logger.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+
+#ifdef __linux__
+  #include <sys/epoll.h>
+  #include <sys/eventfd.h>
+  #include <unistd.h>
+#endif
+
+namespace dotname {
+
+  AsyncHttpClient::AsyncHttpClient (std::size_t maxIdleHandles) : maxIdleHandles_ (maxIdleHandles) {
+    curl_global_init (CURL_GLOBAL_DEFAULT);
+    multi_ = curl_multi_init ();
+    if (!multi_) {
+      LOG_E_STREAM << "curl_multi_init() failed" << std::endl;
+      return;
+    }
+
+#ifdef __linux__
+    epollFd_ = epoll_create1 (EPOLL_CLOEXEC);
+    wakeFd_ = eventfd (0, EFD_NONBLOCK | EFD_CLOEXEC);
+    epoll_event wakeEvent{};
+    wakeEvent.events = EPOLLIN;
+    wakeEvent.data.fd = wakeFd_;
+    if (epollFd_ < 0 || wakeFd_ < 0
+        || epoll_ctl (epollFd_, EPOLL_CTL_ADD, wakeFd_, &wakeEvent) != 0) {
+      LOG_E_STREAM << "Error: Could not set up epoll for async HTTP" << std::endl;
+      return;
+    }
+    curl_multi_setopt (multi_, CURLMOPT_SOCKETFUNCTION, &AsyncHttpClient::onSocket);
+    curl_multi_setopt (multi_, CURLMOPT_SOCKETDATA, this);
+    curl_multi_setopt (multi_, CURLMOPT_TIMERFUNCTION, &AsyncHttpClient::onTimer);
+    curl_multi_setopt (multi_, CURLMOPT_TIMERDATA, this);
+#endif
+
+    driver_ = std::thread (&AsyncHttpClient::run, this);
+  }
+
+  AsyncHttpClient::~AsyncHttpClient () {
+    {
+      std::lock_guard<std::mutex> lock (pendingMutex_);
+      stopping_.store (true);
+    }
+    if (driver_.joinable ()) {
+      wake ();
+      driver_.join ();
+    }
+
+    // whatever the driver did not get to is aborted here
+    for (Transfer* transfer : std::unordered_set<Transfer*> (active_)) {
+      curl_multi_remove_handle (multi_, transfer->handle);
+      finish (transfer, CURLE_ABORTED_BY_CALLBACK);
+    }
+    std::vector<std::unique_ptr<Transfer> > pending;
+    {
+      std::lock_guard<std::mutex> lock (pendingMutex_);
+      pending.swap (pending_);
+    }
+    for (std::unique_ptr<Transfer>& transfer : pending) {
+      finish (transfer.release (), CURLE_ABORTED_BY_CALLBACK);
+    }
+
+    for (CURL* handle : idle_) {
+      curl_easy_cleanup (handle);
+    }
+    if (multi_) {
+      curl_multi_cleanup (multi_);
+    }
+#ifdef __linux__
+    if (wakeFd_ >= 0) {
+      close (wakeFd_);
+    }
+    if (epollFd_ >= 0) {
+      close (epollFd_);
+    }
+#endif
+    curl_global_cleanup ();
+  }
+
+  void AsyncHttpClient::fetch (const std::string& url, Callback callback) {
+    fetch (url, HttpClient::Validators{}, std::move (callback));
+  }
+
+  void AsyncHttpClient::fetch (const std::string& url, const HttpClient::Validators& validators,
+                               Callback callback) {
+    fetch (url, validators, nullptr, std::move (callback));
+  }
+
+  void AsyncHttpClient::fetch (const std::string& url, const HttpClient::Validators& validators,
+                               HttpClient::Sink sink, Callback callback) {
+    auto transfer = std::make_unique<Transfer> ();
+    transfer->url = url;
+    transfer->validators = validators;
+    transfer->sink = std::move (sink);
+    transfer->callback = std::move (callback);
+    {
+      std::lock_guard<std::mutex> lock (pendingMutex_);
+      if (!stopping_.load () && driver_.joinable ()) {
+        pending_.push_back (std::move (transfer));
+        ++inFlight_;
+      }
+    }
+    if (transfer) {
+      ++inFlight_;
+      finish (transfer.release (), CURLE_ABORTED_BY_CALLBACK);
+      return;
+    }
+    wake ();
+  }
+
+  std::future<AsyncHttpClient::Response> AsyncHttpClient::fetch (const std::string& url) {
+    auto promise = std::make_shared<std::promise<Response> > ();
+    std::future<Response> future = promise->get_future ();
+    fetch (url, [promise] (Response&& response) { promise->set_value (std::move (response)); });
+    return future;
+  }
+
+  void AsyncHttpClient::wake () {
+#ifdef __linux__
+    const std::uint64_t one = 1;
+    if (write (wakeFd_, &one, sizeof (one)) < 0 && errno != EAGAIN) {
+      LOG_E_STREAM << "Error: Could not wake async HTTP driver" << std::endl;
+    }
+#else
+    curl_multi_wakeup (multi_);
+#endif
+  }
+
+  void AsyncHttpClient::run () {
+    int running = 0;
+#ifdef __linux__
+    std::array<epoll_event, 32> events;
+    while (!stopping_.load ()) {
+      startPending ();
+
+      int waitMs = -1;
+      if (timerArmed_) {
+        const auto left = std::chrono::duration_cast<std::chrono::milliseconds> (
+            timerDeadline_ - std::chrono::steady_clock::now ());
+        waitMs = static_cast<int> (std::clamp<std::int64_t> (left.count (), 0, 60000));
+      }
+      const int ready
+          = epoll_wait (epollFd_, events.data (), static_cast<int> (events.size ()), waitMs);
+      if (ready < 0 && errno != EINTR) {
+        LOG_E_STREAM << "Error: epoll_wait failed, async HTTP stopped" << std::endl;
+        break;
+      }
+
+      for (int i = 0; i < ready; ++i) {
+        const int fd = events[i].data.fd;
+        if (fd == wakeFd_) {
+          std::uint64_t count = 0;
+          while (read (wakeFd_, &count, sizeof (count)) > 0) {
+          }
+          continue;
+        }
+        int flags = 0;
+        if (events[i].events & EPOLLIN) {
+          flags |= CURL_CSELECT_IN;
+        }
+        if (events[i].events & EPOLLOUT) {
+          flags |= CURL_CSELECT_OUT;
+        }
+        if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+          flags |= CURL_CSELECT_ERR;
+        }
+        curl_multi_socket_action (multi_, fd, flags, &running);
+      }
+
+      if (timerArmed_ && std::chrono::steady_clock::now () >= timerDeadline_) {
+        timerArmed_ = false;
+        curl_multi_socket_action (multi_, CURL_SOCKET_TIMEOUT, 0, &running);
+      }
+      finishDone ();
+    }
+#else
+    while (!stopping_.load ()) {
+      startPending ();
+      curl_multi_perform (multi_, &running);
+      finishDone ();
+      curl_multi_poll (multi_, nullptr, 0, 1000, nullptr);
+    }
+#endif
+  }
+
+  void AsyncHttpClient::startPending () {
+    std::vector<std::unique_ptr<Transfer> > pending;
+    {
+      std::lock_guard<std::mutex> lock (pendingMutex_);
+      pending.swap (pending_);
+    }
+
+    for (std::unique_ptr<Transfer>& owned : pending) {
+      Transfer* transfer = owned.release ();
+      if (!idle_.empty ()) {
+        transfer->handle = idle_.back ();
+        idle_.pop_back ();
+      } else {
+        transfer->handle = curl_easy_init ();
+      }
+      if (!transfer->handle) {
+        finish (transfer, CURLE_FAILED_INIT);
+        continue;
+      }
+
+      HttpClient::setDefaults (transfer->handle, transfer->url, &transfer->response,
+                               &transfer->sink);
+      transfer->headers = HttpClient::setValidators (transfer->handle, transfer->validators);
+      curl_easy_setopt (transfer->handle, CURLOPT_PRIVATE, transfer);
+      active_.insert (transfer);
+      if (curl_multi_add_handle (multi_, transfer->handle) != CURLM_OK) {
+        finish (transfer, CURLE_FAILED_INIT);
+      }
+    }
+  }
+
+  void AsyncHttpClient::finishDone () {
+    int queued = 0;
+    while (CURLMsg* message = curl_multi_info_read (multi_, &queued)) {
+      if (message->msg != CURLMSG_DONE) {
+        continue;
+      }
+      char* priv = nullptr;
+      curl_easy_getinfo (message->easy_handle, CURLINFO_PRIVATE, &priv);
+      Transfer* transfer = reinterpret_cast<Transfer*> (priv);
+      const CURLcode code = message->data.result;
+      curl_easy_getinfo (message->easy_handle, CURLINFO_RESPONSE_CODE,
+                         &transfer->response.status);
+      curl_multi_remove_handle (multi_, message->easy_handle);
+      finish (transfer, code);
+    }
+  }
+
+  void AsyncHttpClient::finish (Transfer* transfer, CURLcode code) {
+    std::unique_ptr<Transfer> owned (transfer);
+    active_.erase (transfer);
+    if (transfer->handle) {
+      curl_easy_reset (transfer->handle);
+      if (idle_.size () < maxIdleHandles_) {
+        idle_.push_back (transfer->handle);
+      } else {
+        curl_easy_cleanup (transfer->handle);
+      }
+    }
+    curl_slist_free_all (transfer->headers);
+
+    transfer->response.code = code;
+    if (code != CURLE_OK) {
+      LOG_E_STREAM << "Fetching " << transfer->url << " failed: " << curl_easy_strerror (code)
+                   << std::endl;
+    } else if (!transfer->response.ok () && !transfer->response.notModified ()) {
+      LOG_E_STREAM << "HTTP " << transfer->response.status << " from " << transfer->url
+                   << std::endl;
+    }
+
+    --inFlight_;
+    try {
+      transfer->callback (std::move (transfer->response));
+    } catch (const std::exception& e) {
+      LOG_E_STREAM << "Error: " << e.what () << std::endl;
+    }
+  }
+
+  int AsyncHttpClient::onSocket (CURL*, curl_socket_t socket, int what, void* self, void* socketp) {
+#ifdef __linux__
+    AsyncHttpClient* client = static_cast<AsyncHttpClient*> (self);
+    if (what == CURL_POLL_REMOVE) {
+      // fails harmlessly when curl already closed the socket
+      epoll_ctl (client->epollFd_, EPOLL_CTL_DEL, socket, nullptr);
+      return 0;
+    }
+
+    epoll_event event{};
+    event.data.fd = socket;
+    event.events = 0;
+    if (what & CURL_POLL_IN) {
+      event.events |= EPOLLIN;
+    }
+    if (what & CURL_POLL_OUT) {
+      event.events |= EPOLLOUT;
+    }
+    // a reused descriptor number may or may not still be registered
+    const int op = socketp ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+    if (epoll_ctl (client->epollFd_, op, socket, &event) != 0) {
+      epoll_ctl (client->epollFd_, socketp ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, socket, &event);
+    }
+    if (!socketp) {
+      curl_multi_assign (client->multi_, socket, client);
+    }
+#else
+    (void)socket;
+    (void)what;
+    (void)self;
+    (void)socketp;
+#endif
+    return 0;
+  }
+
+  int AsyncHttpClient::onTimer (CURLM*, long timeoutMs, void* self) {
+    AsyncHttpClient* client = static_cast<AsyncHttpClient*> (self);
+    client->timerArmed_ = timeoutMs >= 0;
+    if (client->timerArmed_) {
+      client->timerDeadline_
+          = std::chrono::steady_clock::now () + std::chrono::milliseconds (timeoutMs);
+    }
+    return 0;
+  }
+
+} // namespace dotname
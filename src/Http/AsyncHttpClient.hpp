@@ -0,0 +1,97 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#ifndef ASYNCHTTPCLIENT_HPP
+#define ASYNCHTTPCLIENT_HPP
+
+#include "HttpClient.hpp"
+
+#include <curl/curl.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace dotname {
+
+  // Non-blocking HTTP fetches on curl_multi, driven by one background thread.
+  //
+  // The driver waits on the transfers' sockets with epoll (curl_multi_poll on
+  // other platforms), so any number of slow upstreams cost one thread and never
+  // block the caller. Completion callbacks run on the driver thread and must
+  // not block; hand heavy work over to another thread.
+  class AsyncHttpClient {
+  public:
+    using Response = HttpClient::Response;
+    using Callback = std::function<void (Response&&)>;
+
+    explicit AsyncHttpClient (std::size_t maxIdleHandles = 8);
+    // Transfers still in flight complete with CURLE_ABORTED_BY_CALLBACK
+    ~AsyncHttpClient ();
+    AsyncHttpClient (const AsyncHttpClient&) = delete;
+    AsyncHttpClient& operator= (const AsyncHttpClient&) = delete;
+
+    void fetch (const std::string& url, Callback callback);
+    // Conditional fetch, answered with notModified () when the copy is current
+    void fetch (const std::string& url, const HttpClient::Validators& validators,
+                Callback callback);
+    // Streams the body into sink on the driver thread, Response::body stays empty
+    void fetch (const std::string& url, const HttpClient::Validators& validators,
+                HttpClient::Sink sink, Callback callback);
+    std::future<Response> fetch (const std::string& url);
+
+    std::size_t inFlight () const {
+      return inFlight_.load ();
+    }
+
+  private:
+    struct Transfer {
+      CURL* handle = nullptr;
+      std::string url;
+      HttpClient::Validators validators;
+      curl_slist* headers = nullptr;
+      HttpClient::Sink sink;
+      Response response;
+      Callback callback;
+    };
+
+    void run ();
+    void wake ();
+    void startPending ();
+    void finishDone ();
+    void finish (Transfer* transfer, CURLcode code);
+
+    static int onSocket (CURL* handle, curl_socket_t socket, int what, void* self, void* socketp);
+    static int onTimer (CURLM* multi, long timeoutMs, void* self);
+
+    CURLM* multi_ = nullptr;
+    std::thread driver_;
+    std::atomic<bool> stopping_{ false };
+    std::atomic<std::size_t> inFlight_{ 0 };
+
+    std::mutex pendingMutex_;
+    std::vector<std::unique_ptr<Transfer> > pending_;
+    std::unordered_set<Transfer*> active_; // driver thread only
+    std::vector<CURL*> idle_;             // driver thread only
+    std::size_t maxIdleHandles_;
+
+    // curl timer, driver thread only
+    bool timerArmed_ = false;
+    std::chrono::steady_clock::time_point timerDeadline_;
+
+#ifdef __linux__
+    int epollFd_ = -1;
+    int wakeFd_ = -1;
+#endif
+  };
+
+} // namespace dotname
+
+#endif // ASYNCHTTPCLIENT_HPP
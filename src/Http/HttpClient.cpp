@@ -0,0 +1,200 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include "HttpClient.hpp"
+
+#include <Logger/Logger.hpp>
+
+#include <cctype>
+
+namespace dotname {
+
+  namespace {
+    size_t writeCallback (void* contents, size_t size, size_t nmemb, void* userp) {
+      static_cast<std::string*> (userp)->append (static_cast<char*> (contents), size * nmemb);
+      return size * nmemb;
+    }
+
+    size_t sinkCallback (void* contents, size_t size, size_t nmemb, void* userp) {
+      const HttpClient::Sink& sink = *static_cast<const HttpClient::Sink*> (userp);
+      // exceptions must not unwind through curl
+      try {
+        return sink (static_cast<const char*> (contents), size * nmemb) ? size * nmemb : 0;
+      } catch (const std::exception& e) {
+        LOG_E_STREAM << "Error: " << e.what () << std::endl;
+        return 0;
+      }
+    }
+
+    // value of "name: value" when line is that header, names are case insensitive
+    bool headerValue (const char* line, size_t length, const char* name, std::string& value) {
+      size_t i = 0;
+      for (; name[i] != '\0'; ++i) {
+        if (i >= length
+            || std::tolower (static_cast<unsigned char> (line[i]))
+                   != std::tolower (static_cast<unsigned char> (name[i]))) {
+          return false;
+        }
+      }
+      if (i >= length || line[i] != ':') {
+        return false;
+      }
+      size_t begin = i + 1;
+      size_t end = length;
+      while (begin < end && (line[begin] == ' ' || line[begin] == '\t')) {
+        ++begin;
+      }
+      while (end > begin && std::isspace (static_cast<unsigned char> (line[end - 1]))) {
+        --end;
+      }
+      value.assign (line + begin, end - begin);
+      return true;
+    }
+
+    size_t headerCallback (char* line, size_t size, size_t nitems, void* userp) {
+      const size_t length = size * nitems;
+      HttpClient::Response* response = static_cast<HttpClient::Response*> (userp);
+      // a redirect starts another response, only the final one's validators count
+      if (length >= 5 && std::string (line, 5) == "HTTP/") {
+        response->etag.clear ();
+        response->lastModified.clear ();
+      } else if (!headerValue (line, length, "ETag", response->etag)) {
+        headerValue (line, length, "Last-Modified", response->lastModified);
+      }
+      return length;
+    }
+  } // namespace
+
+  HttpClient::HttpClient (std::size_t maxIdleHandles) : maxIdleHandles_ (maxIdleHandles) {
+    curl_global_init (CURL_GLOBAL_DEFAULT);
+
+    share_ = curl_share_init ();
+    if (share_) {
+      curl_share_setopt (share_, CURLSHOPT_LOCKFUNC, &HttpClient::lockShare);
+      curl_share_setopt (share_, CURLSHOPT_UNLOCKFUNC, &HttpClient::unlockShare);
+      curl_share_setopt (share_, CURLSHOPT_USERDATA, this);
+      curl_share_setopt (share_, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+      // not CURL_LOCK_DATA_CONNECT: a connection cache must not be used by
+      // concurrent transfers, every pooled handle keeps its own connections
+      curl_share_setopt (share_, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    } else {
+      LOG_W_STREAM << "Warning: curl_share_init() failed, DNS and TLS sessions are not shared"
+                   << std::endl;
+    }
+  }
+
+  HttpClient::~HttpClient () {
+    // easy handles have to leave the share before it is destroyed
+    {
+      std::lock_guard<std::mutex> lock (poolMutex_);
+      for (CURL* handle : idle_) {
+        curl_easy_cleanup (handle);
+      }
+      idle_.clear ();
+    }
+    if (share_) {
+      curl_share_cleanup (share_);
+    }
+    curl_global_cleanup ();
+  }
+
+  void HttpClient::lockShare (CURL*, curl_lock_data data, curl_lock_access, void* self) {
+    static_cast<HttpClient*> (self)->shareLocks_[data].lock ();
+  }
+
+  void HttpClient::unlockShare (CURL*, curl_lock_data data, void* self) {
+    static_cast<HttpClient*> (self)->shareLocks_[data].unlock ();
+  }
+
+  CURL* HttpClient::acquire () {
+    {
+      std::lock_guard<std::mutex> lock (poolMutex_);
+      if (!idle_.empty ()) {
+        CURL* handle = idle_.back ();
+        idle_.pop_back ();
+        return handle;
+      }
+    }
+    return curl_easy_init ();
+  }
+
+  void HttpClient::release (CURL* handle) {
+    // reset drops the options but keeps the handle's own connection and DNS caches
+    curl_easy_reset (handle);
+    {
+      std::lock_guard<std::mutex> lock (poolMutex_);
+      if (idle_.size () < maxIdleHandles_) {
+        idle_.push_back (handle);
+        return;
+      }
+    }
+    curl_easy_cleanup (handle);
+  }
+
+  void HttpClient::setDefaults (CURL* handle, const std::string& url, Response* response,
+                                const Sink* sink) {
+    curl_easy_setopt (handle, CURLOPT_URL, url.c_str ());
+    curl_easy_setopt (handle, CURLOPT_SSL_VERIFYPEER, 0L); /* temporary - todo cert */
+    curl_easy_setopt (handle, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt (handle, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt (handle, CURLOPT_FOLLOWLOCATION, 1L);
+    curl_easy_setopt (handle, CURLOPT_ACCEPT_ENCODING, "");
+    curl_easy_setopt (handle, CURLOPT_CONNECTTIMEOUT, 10L);
+    curl_easy_setopt (handle, CURLOPT_TIMEOUT, 30L);
+    if (sink && *sink) {
+      curl_easy_setopt (handle, CURLOPT_WRITEFUNCTION, sinkCallback);
+      curl_easy_setopt (handle, CURLOPT_WRITEDATA, sink);
+    } else {
+      curl_easy_setopt (handle, CURLOPT_WRITEFUNCTION, writeCallback);
+      curl_easy_setopt (handle, CURLOPT_WRITEDATA, &response->body);
+    }
+    curl_easy_setopt (handle, CURLOPT_HEADERFUNCTION, headerCallback);
+    curl_easy_setopt (handle, CURLOPT_HEADERDATA, response);
+  }
+
+  curl_slist* HttpClient::setValidators (CURL* handle, const Validators& validators) {
+    curl_slist* headers = nullptr;
+    if (!validators.etag.empty ()) {
+      headers = curl_slist_append (headers, ("If-None-Match: " + validators.etag).c_str ());
+    }
+    if (!validators.lastModified.empty ()) {
+      headers = curl_slist_append (headers,
+                                   ("If-Modified-Since: " + validators.lastModified).c_str ());
+    }
+    if (headers) {
+      curl_easy_setopt (handle, CURLOPT_HTTPHEADER, headers);
+    }
+    return headers;
+  }
+
+  HttpClient::Response HttpClient::get (const std::string& url, const Validators& validators,
+                                        const Sink& sink) {
+    Response response;
+    CURL* handle = acquire ();
+    if (!handle) {
+      LOG_E_STREAM << "curl_easy_init() failed" << std::endl;
+      return response;
+    }
+
+    setDefaults (handle, url, &response, &sink);
+    curl_slist* headers = setValidators (handle, validators);
+    if (share_) {
+      curl_easy_setopt (handle, CURLOPT_SHARE, share_);
+    }
+    response.code = curl_easy_perform (handle);
+    if (response.code == CURLE_OK) {
+      curl_easy_getinfo (handle, CURLINFO_RESPONSE_CODE, &response.status);
+    }
+    release (handle);
+    curl_slist_free_all (headers);
+
+    if (response.code != CURLE_OK) {
+      LOG_E_STREAM << "curl_easy_perform() failed: " << curl_easy_strerror (response.code)
+                   << std::endl;
+    } else if (!response.ok () && !response.notModified ()) {
+      LOG_E_STREAM << "HTTP " << response.status << " from " << url << std::endl;
+    }
+    return response;
+  }
+
+} // namespace dotname
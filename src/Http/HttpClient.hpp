@@ -0,0 +1,89 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#ifndef HTTPCLIENT_HPP
+#define HTTPCLIENT_HPP
+
+#include <curl/curl.h>
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace dotname {
+
+  // Blocking HTTP client over a pool of reusable curl easy handles.
+  //
+  // All handles share one DNS and TLS session cache (CURLSH) and every pooled
+  // handle keeps its own keep-alive connections, so repeated fetches of the
+  // same host skip DNS and usually TCP + TLS as well. Thread safe.
+  class HttpClient {
+  public:
+    struct Response {
+      CURLcode code = CURLE_FAILED_INIT;
+      long status = 0;
+      std::string body;
+      // validators of the response, empty when the server sends none
+      std::string etag;
+      std::string lastModified;
+
+      bool ok () const {
+        return code == CURLE_OK && status >= 200 && status < 300;
+      }
+      // 304 to a conditional request, the body was not transferred
+      bool notModified () const {
+        return code == CURLE_OK && status == 304;
+      }
+    };
+
+    // Validators of a previously fetched copy, sent as If-None-Match / If-Modified-Since
+    struct Validators {
+      std::string etag;
+      std::string lastModified;
+
+      bool empty () const {
+        return etag.empty () && lastModified.empty ();
+      }
+    };
+
+    // Gets the body chunk by chunk as it arrives instead of Response::body,
+    // returning false aborts the transfer
+    using Sink = std::function<bool (const char* data, std::size_t size)>;
+
+    explicit HttpClient (std::size_t maxIdleHandles = 8);
+    ~HttpClient ();
+    HttpClient (const HttpClient&) = delete;
+    HttpClient& operator= (const HttpClient&) = delete;
+
+    Response get (const std::string& url, const Validators& validators = {},
+                  const Sink& sink = nullptr);
+
+    // Options every request of the bot uses, the body and validators are stored in response,
+    // the body goes to sink instead when there is one
+    static void setDefaults (CURL* handle, const std::string& url, Response* response,
+                             const Sink* sink = nullptr);
+    // Makes the request conditional, the returned list is freed with curl_slist_free_all
+    // once the transfer is done
+    static curl_slist* setValidators (CURL* handle, const Validators& validators);
+
+  private:
+    CURL* acquire ();
+    void release (CURL* handle);
+
+    static void lockShare (CURL* handle, curl_lock_data data, curl_lock_access access, void* self);
+    static void unlockShare (CURL* handle, curl_lock_data data, void* self);
+
+    CURLSH* share_ = nullptr;
+    std::array<std::mutex, CURL_LOCK_DATA_LAST> shareLocks_;
+
+    std::mutex poolMutex_;
+    std::vector<CURL*> idle_;
+    std::size_t maxIdleHandles_;
+  };
+
+} // namespace dotname
+
+#endif // HTTPCLIENT_HPP
@@ -0,0 +1,53 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#ifndef VALIDATORSTORE_HPP
+#define VALIDATORSTORE_HPP
+
+#include "HttpClient.hpp"
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace dotname {
+
+  // ETag / Last-Modified of the last good response per URL, thread safe.
+  //
+  // Pass get (url) to a fetch to make it conditional; a 304 then means the
+  // copy the validators were stored with is still current.
+  class ValidatorStore {
+  public:
+    HttpClient::Validators get (const std::string& url) const {
+      std::lock_guard<std::mutex> lock (mutex_);
+      auto it = validators_.find (url);
+      return it == validators_.end () ? HttpClient::Validators{} : it->second;
+    }
+
+    // Keeps the validators of a 2xx response
+    void update (const std::string& url, const HttpClient::Response& response) {
+      if (!response.ok ()) {
+        return;
+      }
+      std::lock_guard<std::mutex> lock (mutex_);
+      if (response.etag.empty () && response.lastModified.empty ()) {
+        validators_.erase (url);
+        return;
+      }
+      validators_[url] = HttpClient::Validators{ response.etag, response.lastModified };
+    }
+
+    // Next fetch of url transfers the full body again
+    void forget (const std::string& url) {
+      std::lock_guard<std::mutex> lock (mutex_);
+      validators_.erase (url);
+    }
+
+  private:
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, HttpClient::Validators> validators_;
+  };
+
+} // namespace dotname
+
+#endif // VALIDATORSTORE_HPP
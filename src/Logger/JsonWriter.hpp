@@ -0,0 +1,115 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Flat JSON objects written straight into a character buffer
+
+#ifndef JSONWRITER_HPP
+#define JSONWRITER_HPP
+
+#include <cmath>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+
+#include "fmt/format.h"
+
+// Writes one flat JSON object into a buffer with append (first, last) and
+// push_back, a fmt::memory_buffer or a std::string, and allocates nothing on
+// its own. Strings are escaped as RFC 8259 asks and passed through otherwise,
+// so they are expected to be UTF-8.
+template <typename Buffer> class JsonWriter {
+public:
+  explicit JsonWriter (Buffer& out) : out_ (out) {
+  }
+
+  void begin () {
+    out_.push_back ('{');
+    first_ = true;
+  }
+  void end () {
+    out_.push_back ('}');
+  }
+
+  void string (std::string_view key, std::string_view value) {
+    name (key);
+    quoted (value);
+  }
+
+  void boolean (std::string_view key, bool value) {
+    name (key);
+    append (value ? "true" : "false");
+  }
+
+  // Integers as they are, floating point in the shortest exact form, null when not finite
+  template <typename T> void number (std::string_view key, T value) {
+    static_assert (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "not a number");
+    name (key);
+    if constexpr (std::is_floating_point_v<T>) {
+      if (!std::isfinite (value)) {
+        append ("null");
+        return;
+      }
+      fmt::format_to (std::back_inserter (out_), "{}", value);
+    } else {
+      const fmt::format_int digits (value);
+      out_.append (digits.data (), digits.data () + digits.size ());
+    }
+  }
+
+private:
+  void name (std::string_view key) {
+    if (!first_) {
+      out_.push_back (',');
+    }
+    first_ = false;
+    quoted (key);
+    out_.push_back (':');
+  }
+
+  void append (std::string_view text) {
+    out_.append (text.data (), text.data () + text.size ());
+  }
+
+  // runs that need no escaping are copied at once
+  void quoted (std::string_view text) {
+    static constexpr char hex[] = "0123456789abcdef";
+    out_.push_back ('"');
+    std::size_t plain = 0;
+    for (std::size_t i = 0; i < text.size (); ++i) {
+      const auto c = static_cast<unsigned char> (text[i]);
+      if (c >= 0x20 && c != '"' && c != '\\') {
+        continue;
+      }
+      append (text.substr (plain, i - plain));
+      plain = i + 1;
+      switch (c) {
+      case '"':
+        append ("\\\"");
+        break;
+      case '\\':
+        append ("\\\\");
+        break;
+      case '\n':
+        append ("\\n");
+        break;
+      case '\r':
+        append ("\\r");
+        break;
+      case '\t':
+        append ("\\t");
+        break;
+      default: {
+        const char escaped[] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xf] };
+        out_.append (escaped, escaped + sizeof (escaped));
+        break;
+      }
+      }
+    }
+    append (text.substr (plain));
+    out_.push_back ('"');
+  }
+
+  Buffer& out_;
+  bool first_ = true;
+};
+
+#endif // JSONWRITER_HPP
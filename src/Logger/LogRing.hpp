@@ -0,0 +1,92 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Lock-free bounded queue between logging threads and the log writer
+
+#ifndef LOGRING_HPP
+#define LOGRING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+// Bounded lock-free queue for many producers and one consumer (Vyukov's MPMC
+// ring). Every slot carries a sequence number telling whose turn it is, so a
+// push is one CAS on the tail plus a store, and a producer never waits for
+// another one except when the ring is full.
+template <typename T> class LogRing {
+public:
+  // capacity is rounded up to a power of two, at least 2
+  explicit LogRing (std::size_t capacity) : mask_ (roundUp (capacity) - 1) {
+    slots_ = std::make_unique<Slot[]> (mask_ + 1);
+    for (std::size_t i = 0; i <= mask_; ++i) {
+      slots_[i].sequence.store (i, std::memory_order_relaxed);
+    }
+  }
+  LogRing (const LogRing&) = delete;
+  LogRing& operator= (const LogRing&) = delete;
+
+  std::size_t capacity () const {
+    return mask_ + 1;
+  }
+
+  // Any thread; false when the ring is full, value is left untouched then
+  bool tryPush (T& value) {
+    std::size_t tail = tail_.load (std::memory_order_relaxed);
+    for (;;) {
+      Slot& slot = slots_[tail & mask_];
+      const std::size_t sequence = slot.sequence.load (std::memory_order_acquire);
+      const auto turn = static_cast<std::ptrdiff_t> (sequence - tail);
+      if (turn == 0) {
+        if (tail_.compare_exchange_weak (tail, tail + 1, std::memory_order_relaxed)) {
+          slot.value = std::move (value);
+          slot.sequence.store (tail + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (turn < 0) {
+        return false;
+      } else {
+        tail = tail_.load (std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Consumer thread only; false when the ring is empty
+  bool tryPop (T& value) {
+    Slot& slot = slots_[head_ & mask_];
+    if (slot.sequence.load (std::memory_order_acquire) != head_ + 1) {
+      return false;
+    }
+    value = std::move (slot.value);
+    slot.sequence.store (head_ + mask_ + 1, std::memory_order_release);
+    ++head_;
+    return true;
+  }
+
+  // Consumer thread only
+  bool empty () const {
+    return slots_[head_ & mask_].sequence.load (std::memory_order_acquire) != head_ + 1;
+  }
+
+private:
+  struct Slot {
+    std::atomic<std::size_t> sequence{ 0 };
+    T value{};
+  };
+
+  static std::size_t roundUp (std::size_t capacity) {
+    std::size_t size = 2;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    return size;
+  }
+
+  const std::size_t mask_;
+  std::unique_ptr<Slot[]> slots_;
+  // producers and the consumer on separate cache lines
+  alignas (64) std::atomic<std::size_t> tail_{ 0 };
+  alignas (64) std::size_t head_ = 0;
+};
+
+#endif // LOGRING_HPP
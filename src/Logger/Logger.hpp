@@ -5,18 +5,33 @@
 #ifndef LOGGER_HPP
 #define LOGGER_HPP
 
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
 #include <fstream>
+#include <functional>
+#include <initializer_list>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <thread>
+#include <type_traits>
 
+#include "JsonWriter.hpp"
+#include "LogRing.hpp"
+#include "RotatingFile.hpp"
 #include "fmt/core.h"
+#include "fmt/format.h"
 
 #ifdef _WIN32
   #ifndef NOMINMAX
@@ -49,6 +64,9 @@
   #undef LoadImage
   #undef DrawTextEx
 
+#elif defined(__linux__) && !defined(__EMSCRIPTEN__)
+  #include <sys/syscall.h>
+  #include <unistd.h>
 #endif
 
 // Function name macros for different compilers
@@ -65,16 +83,21 @@ class Logger {
 private:
   std::mutex logMutex_;
   std::ostringstream messageStream_;
-  std::ofstream logFile_;
-  bool isSkipLine_ = false;
+  RotatingFile logFile_;
+  RotatingFile jsonFile_;
+  std::atomic<bool> isSkipLine_{ false };
 
 protected:
   Logger () = default;
   ~Logger () {
+    disableAsync ();
     std::lock_guard<std::mutex> lock (logMutex_);
     if (logFile_.is_open ()) {
       logFile_.close ();
     }
+    if (jsonFile_.is_open ()) {
+      jsonFile_.close ();
+    }
   }
 
 public:
@@ -98,9 +121,276 @@ public:
 
 public:
   enum class Level { LOG_DEBUG, LOG_INFO, LOG_WARNING, LOG_ERROR, LOG_CRITICAL };
+  enum class Overflow { Block, Drop, Count };
+  // Digits of a second shown after the time in headers and the log file
+  enum class TimePrecision { Seconds, Milliseconds, Microseconds };
+
+  // "dd-mm-YYYY HH:MM:SS[.fff[fff]]" of a log record
+  struct Timestamp {
+    char text[32];
+    std::size_t size = 0;
+
+    std::string_view view () const {
+      return std::string_view (text, size);
+    }
+  };
+  // Grows on the heap only for lines longer than its stack storage
+  using Line = fmt::basic_memory_buffer<char, 512>;
+
+  // One key and value of a LOG_*_KV record. It holds views only and lives as
+  // long as the logging call that writes it out.
+  class Field {
+  public:
+    Field (std::string_view key, std::string_view value)
+        : key_ (key), kind_ (Kind::String), text_ (value) {
+    }
+    Field (std::string_view key, const char* value)
+        : Field (key, std::string_view (value ? value : "")) {
+    }
+    Field (std::string_view key, bool value) : key_ (key), kind_ (Kind::Bool), flag_ (value) {
+    }
+    template <typename T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>,
+                                           int> = 0>
+    Field (std::string_view key, T value)
+        : key_ (key), kind_ (std::is_signed_v<T> ? Kind::Signed : Kind::Unsigned) {
+      if constexpr (std::is_signed_v<T>) {
+        signed_ = value;
+      } else {
+        unsigned_ = value;
+      }
+    }
+    template <typename T, std::enable_if_t<std::is_floating_point_v<T>, int> = 0>
+    Field (std::string_view key, T value)
+        : key_ (key), kind_ (Kind::Real), real_ (static_cast<double> (value)) {
+    }
+
+    // " key=value" after the message of a text line
+    void appendText (Line& line) const {
+      auto out = std::back_inserter (line);
+      switch (kind_) {
+      case Kind::String:
+        fmt::format_to (out, " {}={}", key_, text_);
+        break;
+      case Kind::Signed:
+        fmt::format_to (out, " {}={}", key_, signed_);
+        break;
+      case Kind::Unsigned:
+        fmt::format_to (out, " {}={}", key_, unsigned_);
+        break;
+      case Kind::Real:
+        fmt::format_to (out, " {}={}", key_, real_);
+        break;
+      case Kind::Bool:
+        fmt::format_to (out, " {}={}", key_, flag_);
+        break;
+      }
+    }
+
+    void appendJson (JsonWriter<Line>& json) const {
+      switch (kind_) {
+      case Kind::String:
+        json.string (key_, text_);
+        break;
+      case Kind::Signed:
+        json.number (key_, signed_);
+        break;
+      case Kind::Unsigned:
+        json.number (key_, unsigned_);
+        break;
+      case Kind::Real:
+        json.number (key_, real_);
+        break;
+      case Kind::Bool:
+        json.boolean (key_, flag_);
+        break;
+      }
+    }
+
+  private:
+    enum class Kind { String, Signed, Unsigned, Real, Bool };
+
+    std::string_view key_;
+    Kind kind_;
+    std::string_view text_;
+    std::int64_t signed_ = 0;
+    std::uint64_t unsigned_ = 0;
+    double real_ = 0;
+    bool flag_ = false;
+  };
 
 private:
-  Level currentLevel_ = Level::LOG_INFO;
+  // everything the compile-time LOG_MIN_LEVEL leaves in is logged unless lowered here
+  std::atomic<Level> currentLevel_{ Level::LOG_DEBUG };
+
+public:
+  void setLevel (Level level) {
+    currentLevel_.store (level, std::memory_order_relaxed);
+  }
+  Level getLevel () const {
+    return currentLevel_.load (std::memory_order_relaxed);
+  }
+  // Checked by the LOG_* macros before anything is formatted
+  bool isEnabled (Level level) const {
+    return static_cast<int> (level) >= static_cast<int> (getLevel ());
+  }
+
+private:
+
+  // A formatted line for the console, one for the log file and one for the JSON
+  // log, empty when they are off
+  struct Record {
+    Level level = Level::LOG_INFO;
+    std::string console;
+    std::string file;
+    std::string json;
+  };
+
+  std::mutex asyncMutex_;
+  std::unique_ptr<LogRing<Record> > ring_;
+  Overflow overflow_ = Overflow::Block;
+  std::atomic<bool> async_{ false };
+  // threads between checking async_ and having pushed their record
+  std::atomic<int> pushing_{ 0 };
+  std::atomic<bool> fileEnabled_{ false };
+  std::atomic<bool> jsonEnabled_{ false };
+  std::atomic<std::uint64_t> enqueued_{ 0 };
+  std::atomic<std::uint64_t> written_{ 0 };
+  std::atomic<std::uint64_t> dropped_{ 0 };
+  std::atomic<bool> writerSleeping_{ false };
+  std::thread writer_;
+  std::mutex wakeMutex_;
+  std::condition_variable wake_;
+  std::condition_variable flushed_;
+  bool stopWriter_ = false;
+
+  static constexpr std::size_t maxBatch_ = 256;
+
+  bool logAsync (Level level, std::string_view message, std::string_view caller,
+                 const Timestamp& stamp, const Line& json, bool endLine) {
+    pushing_.fetch_add (1);
+    if (!async_.load ()) {
+      pushing_.fetch_sub (1);
+      return false;
+    }
+    Record record;
+    record.level = level;
+    Line line;
+    appendHeader (line, stamp, caller, level);
+    line.append (message);
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+    line.append (std::string_view ("\033[0m"));
+#endif
+    if (endLine) {
+      line.push_back ('\n');
+    }
+    record.console.assign (line.data (), line.size ());
+    if (fileEnabled_.load ()) {
+      line.clear ();
+      appendFileLine (line, stamp, caller, level, message);
+      record.file.assign (line.data (), line.size ());
+    }
+    record.json.assign (json.data (), json.size ());
+
+    bool pushed = ring_->tryPush (record);
+    while (!pushed && overflow_ == Overflow::Block) {
+      wakeWriter ();
+      std::this_thread::yield ();
+      pushed = ring_->tryPush (record);
+    }
+    if (pushed) {
+      enqueued_.fetch_add (1);
+      if (writerSleeping_.load ()) {
+        wakeWriter ();
+      }
+    } else {
+      dropped_.fetch_add (1);
+    }
+    pushing_.fetch_sub (1);
+    // a crash right after must not lose it
+    if (pushed && level == Level::LOG_CRITICAL) {
+      flush ();
+    }
+    return true;
+  }
+
+  void wakeWriter () {
+    std::lock_guard<std::mutex> lock (wakeMutex_);
+    wake_.notify_one ();
+  }
+
+  void runWriter () {
+    std::string out;
+    std::string err;
+    std::string file;
+    std::string json;
+    std::uint64_t reported = 0;
+    Record record;
+    for (;;) {
+      std::size_t count = 0;
+      while (count < maxBatch_ && ring_->tryPop (record)) {
+        const bool toErr = record.level == Level::LOG_ERROR || record.level == Level::LOG_CRITICAL;
+        (toErr ? err : out) += record.console;
+        file += record.file;
+        json += record.json;
+        ++count;
+      }
+      const std::uint64_t dropped = dropped_.load ();
+      if (overflow_ == Overflow::Count && dropped != reported) {
+        err += fmt::format ("[{}] {} log records dropped\n", *std::atomic_load (&headerName_),
+                            dropped - reported);
+        reported = dropped;
+      }
+      writeBatch (out, err, file, json);
+      if (count != 0) {
+        written_.fetch_add (count);
+        std::lock_guard<std::mutex> lock (wakeMutex_);
+        flushed_.notify_all ();
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lock (wakeMutex_);
+      writerSleeping_.store (true);
+      if (ring_->empty () && !stopWriter_) {
+        flushed_.notify_all ();
+        wake_.wait_for (lock, std::chrono::milliseconds (50));
+      }
+      writerSleeping_.store (false);
+      if (stopWriter_ && ring_->empty ()) {
+        flushed_.notify_all ();
+        return;
+      }
+    }
+  }
+
+  void writeBatch (std::string& out, std::string& err, std::string& file, std::string& json) {
+    if (!out.empty ()) {
+      std::fwrite (out.data (), 1, out.size (), stdout);
+      std::fflush (stdout);
+      out.clear ();
+    }
+    if (!err.empty ()) {
+      std::fwrite (err.data (), 1, err.size (), stderr);
+      std::fflush (stderr);
+      err.clear ();
+    }
+    if (!file.empty ()) {
+      std::lock_guard<std::mutex> lock (logMutex_);
+      if (logFile_.is_open ()) {
+        // the whole batch in one write
+        logFile_.write (file);
+        logFile_.flush ();
+      }
+      file.clear ();
+    }
+    if (!json.empty ()) {
+      std::lock_guard<std::mutex> lock (logMutex_);
+      if (jsonFile_.is_open ()) {
+        jsonFile_.write (json);
+        jsonFile_.flush ();
+      }
+      json.clear ();
+    }
+  }
 
 public:
   void debug (const std::string& message, const std::string& caller = "") {
@@ -124,45 +414,85 @@ public:
   }
 
   void log (Level level, const std::string& message, const std::string& caller = "") {
+    if (!isEnabled (level)) {
+      return;
+    }
+    write (level, message, caller, {});
+  }
+
+  // The console and the log file get fields after the message as key=value,
+  // the JSON log gets them as members of the record
+  void logFields (Level level, std::string_view message, const char* caller,
+                  std::initializer_list<Field> fields) {
+    if (!isEnabled (level)) {
+      return;
+    }
+    write (level, message, caller, fields);
+  }
+
+  // Formats only when level is enabled
+  template <typename... Args>
+  void logFmtMessage (Level level, fmt::format_string<Args...> format, const char* caller,
+                      Args&&... args) {
+    if (!isEnabled (level)) {
+      return;
+    }
+    log (level, fmt::format (format, std::forward<Args> (args)...), caller);
+  }
+
+private:
+  void write (Level level, std::string_view message, std::string_view caller,
+              std::initializer_list<Field> fields) {
+    // one clock read and one formatted time for every output
+    const auto now = std::chrono::system_clock::now ();
+    const Timestamp stamp = timestamp (now);
+    Line json;
+    if (jsonEnabled_.load ()) {
+      appendJsonLine (json, now, caller, level, message, fields);
+    }
+    Line text;
+    if (fields.size () != 0) {
+      text.append (message);
+      for (const Field& field : fields) {
+        field.appendText (text);
+      }
+      message = std::string_view (text.data (), text.size ());
+    }
+    // a streamed message ends with its own std::endl, one with fields has none
+    const bool endLine = isSkipLine_.load () || fields.size () != 0;
+    if (logAsync (level, message, caller, stamp, json, endLine)) {
+      return;
+    }
+
     std::lock_guard<std::mutex> lock (logMutex_);
-    auto now = std::chrono::system_clock::now ();
-    auto now_time = std::chrono::system_clock::to_time_t (now);
-    std::tm now_tm;
-#ifdef _WIN32
-    localtime_s (&now_tm, &now_time);
-#else
-    localtime_r (&now_time, &now_tm);
-#endif
     // Výstup na konzoli
     if (level == Level::LOG_ERROR || level == Level::LOG_CRITICAL) {
-      logToStream (std::cerr, level, message, caller, now_tm);
+      logToStream (std::cerr, level, message, caller, stamp, endLine);
     } else {
-      logToStream (std::cout, level, message, caller, now_tm);
+      logToStream (std::cout, level, message, caller, stamp, endLine);
     }
     // Výstup do souboru, pokud je povolen
     if (logFile_.is_open ()) {
-      logFile_ << "[" << std::put_time (&now_tm, "%d-%m-%Y %H:%M:%S") << "] ";
-      logFile_ << "[" << (caller.empty () ? "empty caller" : caller) << "] ";
-      logFile_ << "[" << levelToString (level) << "] " << message << std::endl;
+      Line line;
+      appendFileLine (line, stamp, caller, level, message);
+      logFile_.write (std::string_view (line.data (), line.size ()));
+      logFile_.flush ();
+    }
+    if (jsonFile_.is_open () && json.size () != 0) {
+      jsonFile_.write (std::string_view (json.data (), json.size ()));
+      jsonFile_.flush ();
     }
   }
 
-  template <typename... Args>
-  void logFmtMessage (Level level, const std::string& format, const std::string& caller,
-                      Args&&... args) {
-    std::string message = fmt::format (format, std::forward<Args> (args)...);
-    log (level, message, caller);
-  }
-
-public:
-  bool enableFileLogging (const std::string& filename) {
+  bool openSink (RotatingFile& sink, std::atomic<bool>& enabled, const std::string& filename,
+                 const RotatingFile::Policy& policy) {
     std::lock_guard<std::mutex> lock (logMutex_);
     try {
-      logFile_.open (filename, std::ios::out | std::ios::app);
-      return logFile_.is_open ();
-    } catch (const std::ios_base::failure& e) {
-      std::cerr << "Failed to open log file: " << filename << " - " << e.what () << std::endl;
-      return false;
+      if (!sink.open (filename, policy)) {
+        std::cerr << "Failed to open log file: " << filename << std::endl;
+      }
+      enabled.store (sink.is_open ());
+      return sink.is_open ();
     } catch (const std::exception& e) {
       std::cerr << "Failed to open log file: " << filename << " - " << e.what () << std::endl;
       return false;
@@ -172,14 +502,107 @@ public:
     }
   }
 
-  void disableFileLogging () {
+  void closeSink (RotatingFile& sink, std::atomic<bool>& enabled) {
+    // records already queued still reach the file
+    flush ();
     std::lock_guard<std::mutex> lock (logMutex_);
-    if (logFile_.is_open ()) {
-      logFile_.close ();
+    enabled.store (false);
+    if (sink.is_open ()) {
+      sink.close ();
+    }
+  }
+
+public:
+  // Appends to filename forever
+  bool enableFileLogging (const std::string& filename) {
+    return enableFileLogging (filename, RotatingFile::Policy ());
+  }
+
+  // Appends to filename and rotates it as policy says
+  bool enableFileLogging (const std::string& filename, const RotatingFile::Policy& policy) {
+    return openSink (logFile_, fileEnabled_, filename, policy);
+  }
+
+  void disableFileLogging () {
+    closeSink (logFile_, fileEnabled_);
+  }
+
+  // One JSON object per line and record, next to the console and the text log:
+  // {"ts_ns":..,"level":"INF","caller":"..","thread":..,"msg":"..", fields..}
+  bool enableJsonLogging (const std::string& filename,
+                          const RotatingFile::Policy& policy = RotatingFile::Policy ()) {
+    return openSink (jsonFile_, jsonEnabled_, filename, policy);
+  }
+
+  void disableJsonLogging () {
+    closeSink (jsonFile_, jsonEnabled_);
+  }
+
+  // Records are formatted by the logging thread and written by a writer thread,
+  // a batch at a time with one write per stream. What a full ring of capacity
+  // records does with one more is up to overflow: Block waits for room, Drop
+  // drops it and Count drops it and reports how many were dropped. False when
+  // async logging is on already.
+  bool enableAsync (std::size_t capacity = 8192, Overflow overflow = Overflow::Block) {
+    std::lock_guard<std::mutex> lock (asyncMutex_);
+    if (writer_.joinable ()) {
+      return false;
     }
+    ring_ = std::make_unique<LogRing<Record> > (capacity);
+    overflow_ = overflow;
+    {
+      std::lock_guard<std::mutex> wakeLock (wakeMutex_);
+      stopWriter_ = false;
+    }
+    writer_ = std::thread (&Logger::runWriter, this);
+    async_.store (true);
+    return true;
+  }
+
+  // Writes what is queued and logs synchronously again
+  void disableAsync () {
+    std::lock_guard<std::mutex> lock (asyncMutex_);
+    if (!writer_.joinable ()) {
+      return;
+    }
+    async_.store (false);
+    // a record whose thread saw async_ still set is in the ring before the writer stops
+    while (pushing_.load () != 0) {
+      std::this_thread::yield ();
+    }
+    {
+      std::lock_guard<std::mutex> wakeLock (wakeMutex_);
+      stopWriter_ = true;
+    }
+    wake_.notify_all ();
+    writer_.join ();
+    ring_.reset ();
+  }
+
+  bool isAsync () const {
+    return async_.load ();
+  }
+
+  // Waits until every record queued so far is written
+  void flush () {
+    const std::uint64_t target = enqueued_.load ();
+    std::unique_lock<std::mutex> lock (wakeMutex_);
+    wake_.notify_all ();
+    flushed_.wait (lock, [this, target] {
+      return written_.load () >= target || !async_.load () || stopWriter_;
+    });
+  }
+
+  // Records dropped because the ring was full
+  std::uint64_t droppedRecords () const {
+    return dropped_.load ();
   }
 
   std::string levelToString (Level level) const {
+    return levelName (level);
+  }
+
+  static const char* levelName (Level level) {
     switch (level) {
     case Level::LOG_DEBUG:
       return "DBG";
@@ -196,6 +619,58 @@ public:
     }
   }
 
+  void setTimePrecision (TimePrecision precision) {
+    timePrecision_.store (precision, std::memory_order_relaxed);
+  }
+
+  Timestamp timestamp (std::chrono::system_clock::time_point now) const {
+    // local time is formatted once a second per thread, then only copied
+    struct Cached {
+      std::time_t second = -1;
+      char text[20] = {};
+    };
+    thread_local Cached cached;
+
+    const auto sinceEpoch = now.time_since_epoch ();
+    const auto seconds = std::chrono::duration_cast<std::chrono::seconds> (sinceEpoch);
+    const std::time_t second = std::chrono::system_clock::to_time_t (
+        std::chrono::system_clock::time_point (seconds));
+    if (second != cached.second) {
+      std::tm now_tm;
+#ifdef _WIN32
+      localtime_s (&now_tm, &second);
+#else
+      localtime_r (&second, &now_tm);
+#endif
+      std::strftime (cached.text, sizeof (cached.text), "%d-%m-%Y %H:%M:%S", &now_tm);
+      cached.second = second;
+    }
+
+    Timestamp stamp;
+    stamp.size = std::strlen (cached.text);
+    std::memcpy (stamp.text, cached.text, stamp.size);
+    const auto fraction = sinceEpoch - seconds;
+    switch (timePrecision_.load (std::memory_order_relaxed)) {
+    case TimePrecision::Milliseconds:
+      stamp.size = fmt::format_to_n (
+                       stamp.text + stamp.size, sizeof (stamp.text) - stamp.size, ".{:03}",
+                       std::chrono::duration_cast<std::chrono::milliseconds> (fraction).count ())
+                       .out
+                   - stamp.text;
+      break;
+    case TimePrecision::Microseconds:
+      stamp.size = fmt::format_to_n (
+                       stamp.text + stamp.size, sizeof (stamp.text) - stamp.size, ".{:06}",
+                       std::chrono::duration_cast<std::chrono::microseconds> (fraction).count ())
+                       .out
+                   - stamp.text;
+      break;
+    default:
+      break;
+    }
+    return stamp;
+  }
+
   void resetConsoleColor () {
 #ifdef _WIN32
     SetConsoleTextAttribute (GetStdHandle (STD_OUTPUT_HANDLE),
@@ -249,58 +724,104 @@ public:
   }
 
 private:
-  std::string headerName_ = "DotNameLib";
-  bool includeName_ = true;
-  bool includeTime_ = true;
-  bool includeCaller_ = true;
-  bool includeLevel_ = true;
-
-  void logToStream (std::ostream& stream, Level level, const std::string& message,
-                    const std::string& caller, const std::tm& now_tm) {
-    stream << buildHeader (now_tm, caller, level) << message;
+  // read by every logging thread without a lock
+  std::shared_ptr<const std::string> headerName_
+      = std::make_shared<const std::string> ("DotNameLib");
+  std::atomic<bool> includeName_{ true };
+  std::atomic<bool> includeTime_{ true };
+  std::atomic<bool> includeCaller_{ true };
+  std::atomic<bool> includeLevel_{ true };
+
+  std::atomic<TimePrecision> timePrecision_{ TimePrecision::Seconds };
+
+  void logToStream (std::ostream& stream, Level level, std::string_view message,
+                    std::string_view caller, const Timestamp& stamp, bool endLine) {
+    Line header;
+    appendHeader (header, stamp, caller, level);
+    stream.write (header.data (), static_cast<std::streamsize> (header.size ()));
+    stream << message;
     resetConsoleColor ();
-    if (isSkipLine_) {
+    if (endLine) {
       stream << std::endl;
     }
   }
 
-  std::string buildHeader (const std::tm& now_tm, const std::string& caller, Level level) const {
-    std::ostringstream header;
+  void appendHeader (Line& line, const Timestamp& stamp, std::string_view caller,
+                     Level level) const {
+    auto out = std::back_inserter (line);
     if (includeName_) {
-      header << "[" << headerName_ << "] ";
+      out = fmt::format_to (out, "[{}] ", *std::atomic_load (&headerName_));
     }
     if (includeTime_) {
-      header << "[" << std::put_time (&now_tm, "%d-%m-%Y %H:%M:%S") << "] ";
+      out = fmt::format_to (out, "[{}] ", stamp.view ());
     }
     if (includeCaller_ && !caller.empty ()) {
-      header << "[" << caller << "] ";
+      out = fmt::format_to (out, "[{}] ", caller);
     }
     if (includeLevel_) {
-      header << "[" << levelToString (level) << "] ";
+      fmt::format_to (out, "[{}] ", levelName (level));
     }
-    return header.str ();
+  }
+
+  void appendFileLine (Line& line, const Timestamp& stamp, std::string_view caller, Level level,
+                       std::string_view message) const {
+    fmt::format_to (std::back_inserter (line), "[{}] [{}] [{}] {}\n", stamp.view (),
+                    caller.empty () ? "empty caller" : caller, levelName (level), message);
+  }
+
+  void appendJsonLine (Line& line, std::chrono::system_clock::time_point now,
+                       std::string_view caller, Level level, std::string_view message,
+                       std::initializer_list<Field> fields) const {
+    // without the std::endl of a streamed message
+    while (!message.empty () && (message.back () == '\n' || message.back () == '\r')) {
+      message.remove_suffix (1);
+    }
+    JsonWriter<Line> json (line);
+    json.begin ();
+    json.number ("ts_ns",
+                 std::chrono::duration_cast<std::chrono::nanoseconds> (now.time_since_epoch ())
+                     .count ());
+    json.string ("level", levelName (level));
+    json.string ("caller", caller);
+    json.number ("thread", threadId ());
+    json.string ("msg", message);
+    for (const Field& field : fields) {
+      field.appendJson (json);
+    }
+    json.end ();
+    line.push_back ('\n');
+  }
+
+  // The id top and debuggers show where there is one, looked up once per thread
+  static std::uint64_t threadId () {
+    thread_local const std::uint64_t id = [] {
+#ifdef _WIN32
+      return static_cast<std::uint64_t> (GetCurrentThreadId ());
+#elif defined(__linux__) && !defined(__EMSCRIPTEN__)
+      return static_cast<std::uint64_t> (::syscall (SYS_gettid));
+#else
+      return static_cast<std::uint64_t> (
+          std::hash<std::thread::id> () (std::this_thread::get_id ()));
+#endif
+    }();
+    return id;
   }
 
 public:
   // Metody pro nastavení záhlaví zůstávají stejné
   void setHeaderName (const std::string& headerName) {
-    std::lock_guard<std::mutex> lock (logMutex_);
-    headerName_ = headerName;
+    std::atomic_store (&headerName_, std::make_shared<const std::string> (headerName));
   }
   void showHeaderName (bool includeName) {
-    std::lock_guard<std::mutex> lock (logMutex_);
     includeName_ = includeName;
   }
   void showHeaderTime (bool includeTime) {
-    std::lock_guard<std::mutex> lock (logMutex_);
     includeTime_ = includeTime;
   }
   void showHeaderCaller (bool includeCaller) {
-    std::lock_guard<std::mutex> lock (logMutex_);
     includeCaller_ = includeCaller;
   }
   void showHeaderLevel (bool includeLevel) {
-    std::lock_guard<std::mutex> lock (logMutex_);
     includeLevel_ = includeLevel;
   }
   void noHeader (bool noHeader) {
@@ -326,7 +847,7 @@ public:
 public:
   class LogStream {
   public:
-    LogStream (Logger& logger, Level level, const std::string& caller)
+    LogStream (Logger& logger, Level level, const char* caller)
         : logger_ (logger), level_ (level), caller_ (caller) {
     }
     ~LogStream () {
@@ -346,12 +867,12 @@ public:
   private:
     Logger& logger_;
     Level level_;
-    std::string caller_;
+    const char* caller_;
     std::ostringstream oss_;
   };
 
   // Metoda, která vrací objekt LogStream pro streamové logování
-  LogStream stream (Level level, const std::string& caller = "") {
+  LogStream stream (Level level, const char* caller = "") {
     return LogStream (*this, level, caller);
   }
 }; // class Logger
@@ -359,33 +880,46 @@ public:
 // clang-format off
   #define LOG Logger::getInstance()
 
-#ifndef NDEBUG
-  #define LOG_D_STREAM Logger::getInstance().stream(Logger::Level::LOG_DEBUG, FUNCTION_NAME)
-  #define LOG_D_MSG(msg) Logger::getInstance().debug(msg, FUNCTION_NAME)
-  #define LOG_D_FMT(format, ...) Logger::getInstance().logFmtMessage(Logger::Level::LOG_DEBUG, format, FUNCTION_NAME, __VA_ARGS__)
-#else
-  #define LOG_D_STREAM if(0) Logger::getInstance().stream(Logger::Level::LOG_DEBUG, FUNCTION_NAME)
-  #define LOG_D_MSG(msg) do {} while(0)
-  #define LOG_D_FMT(format, ...) do {} while(0)
+// Levels below LOG_MIN_LEVEL are compiled out: 0 debug, 1 info, 2 warning, 3 error, 4 critical
+#ifndef LOG_MIN_LEVEL
+  #ifdef NDEBUG
+    #define LOG_MIN_LEVEL 1
+  #else
+    #define LOG_MIN_LEVEL 0
+  #endif
 #endif
-  
-  //#define LOG_D_STREAM Logger::getInstance().stream(Logger::Level::LOG_DEBUG, FUNCTION_NAME)
-  #define LOG_I_STREAM Logger::getInstance().stream(Logger::Level::LOG_INFO, FUNCTION_NAME)
-  #define LOG_W_STREAM Logger::getInstance().stream(Logger::Level::LOG_WARNING, FUNCTION_NAME)
-  #define LOG_E_STREAM Logger::getInstance().stream(Logger::Level::LOG_ERROR, FUNCTION_NAME)
-  #define LOG_C_STREAM Logger::getInstance().stream(Logger::Level::LOG_CRITICAL, FUNCTION_NAME)
-  
-  //#define LOG_D_MSG(msg) Logger::getInstance().debug(msg, FUNCTION_NAME)
-  #define LOG_I_MSG(msg) Logger::getInstance().info(msg, FUNCTION_NAME)
-  #define LOG_W_MSG(msg) Logger::getInstance().warning(msg, FUNCTION_NAME)
-  #define LOG_E_MSG(msg) Logger::getInstance().error(msg, FUNCTION_NAME)
-  #define LOG_C_MSG(msg) Logger::getInstance().critical(msg, FUNCTION_NAME)
-  
-  //#define LOG_D_FMT(format, ...) Logger::getInstance().logFmtMessage(Logger::Level::LOG_DEBUG, format, FUNCTION_NAME, __VA_ARGS__)
-  #define LOG_I_FMT(format, ...) Logger::getInstance().logFmtMessage(Logger::Level::LOG_INFO, format, FUNCTION_NAME, __VA_ARGS__)
-  #define LOG_W_FMT(format, ...) Logger::getInstance().logFmtMessage(Logger::Level::LOG_WARNING, format, FUNCTION_NAME, __VA_ARGS__)
-  #define LOG_E_FMT(format, ...) Logger::getInstance().logFmtMessage(Logger::Level::LOG_ERROR, format, FUNCTION_NAME, __VA_ARGS__)
-  #define LOG_C_FMT(format, ...) Logger::getInstance().logFmtMessage(Logger::Level::LOG_CRITICAL, format, FUNCTION_NAME, __VA_ARGS__)
+
+  // one branch when disabled, the message and its arguments are not evaluated at all
+  #define LOG_ENABLED(level) (static_cast<int>(level) >= LOG_MIN_LEVEL && Logger::getInstance().isEnabled(level))
+  #define LOG_STREAM_AT(level) if (!LOG_ENABLED(level)) {} else Logger::getInstance().stream(level, FUNCTION_NAME)
+  #define LOG_MSG_AT(level, msg) do { if (LOG_ENABLED(level)) Logger::getInstance().log(level, msg, FUNCTION_NAME); } while (0)
+  #define LOG_FMT_AT(level, format, ...) do { if (LOG_ENABLED(level)) Logger::getInstance().logFmtMessage(level, format, FUNCTION_NAME, __VA_ARGS__); } while (0)
+  #define LOG_KV_AT(level, msg, ...) do { if (LOG_ENABLED(level)) Logger::getInstance().logFields(level, msg, FUNCTION_NAME, { __VA_ARGS__ }); } while (0)
+
+  #define LOG_D_STREAM LOG_STREAM_AT(Logger::Level::LOG_DEBUG)
+  #define LOG_I_STREAM LOG_STREAM_AT(Logger::Level::LOG_INFO)
+  #define LOG_W_STREAM LOG_STREAM_AT(Logger::Level::LOG_WARNING)
+  #define LOG_E_STREAM LOG_STREAM_AT(Logger::Level::LOG_ERROR)
+  #define LOG_C_STREAM LOG_STREAM_AT(Logger::Level::LOG_CRITICAL)
+
+  #define LOG_D_MSG(msg) LOG_MSG_AT(Logger::Level::LOG_DEBUG, msg)
+  #define LOG_I_MSG(msg) LOG_MSG_AT(Logger::Level::LOG_INFO, msg)
+  #define LOG_W_MSG(msg) LOG_MSG_AT(Logger::Level::LOG_WARNING, msg)
+  #define LOG_E_MSG(msg) LOG_MSG_AT(Logger::Level::LOG_ERROR, msg)
+  #define LOG_C_MSG(msg) LOG_MSG_AT(Logger::Level::LOG_CRITICAL, msg)
+
+  #define LOG_D_FMT(format, ...) LOG_FMT_AT(Logger::Level::LOG_DEBUG, format, __VA_ARGS__)
+  #define LOG_I_FMT(format, ...) LOG_FMT_AT(Logger::Level::LOG_INFO, format, __VA_ARGS__)
+  #define LOG_W_FMT(format, ...) LOG_FMT_AT(Logger::Level::LOG_WARNING, format, __VA_ARGS__)
+  #define LOG_E_FMT(format, ...) LOG_FMT_AT(Logger::Level::LOG_ERROR, format, __VA_ARGS__)
+  #define LOG_C_FMT(format, ...) LOG_FMT_AT(Logger::Level::LOG_CRITICAL, format, __VA_ARGS__)
+
+  // LOG_I_KV("Command handled", { "command", name }, { "ms", ms });
+  #define LOG_D_KV(msg, ...) LOG_KV_AT(Logger::Level::LOG_DEBUG, msg, __VA_ARGS__)
+  #define LOG_I_KV(msg, ...) LOG_KV_AT(Logger::Level::LOG_INFO, msg, __VA_ARGS__)
+  #define LOG_W_KV(msg, ...) LOG_KV_AT(Logger::Level::LOG_WARNING, msg, __VA_ARGS__)
+  #define LOG_E_KV(msg, ...) LOG_KV_AT(Logger::Level::LOG_ERROR, msg, __VA_ARGS__)
+  #define LOG_C_KV(msg, ...) LOG_KV_AT(Logger::Level::LOG_CRITICAL, msg, __VA_ARGS__)
 // clang-format on
 
 #endif // LOGGER_HPP
\ No newline at end of file
@@ -0,0 +1,184 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Log file that rotates by size and age
+
+#include "RotatingFile.hpp"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <iostream>
+#include <system_error>
+
+#ifdef _WIN32
+  #include <io.h>
+#else
+  #include <unistd.h>
+#endif
+
+namespace {
+  // Compresses from into to and removes from, keeps from when that fails
+  bool gzipFile (const std::filesystem::path& from, const std::filesystem::path& to) {
+    std::FILE* in = std::fopen (from.string ().c_str (), "rb");
+    if (!in) {
+      return false;
+    }
+    gzFile out = gzopen (to.string ().c_str (), "wb");
+    if (!out) {
+      std::fclose (in);
+      return false;
+    }
+    char chunk[64 * 1024];
+    bool ok = true;
+    std::size_t got = 0;
+    while (ok && (got = std::fread (chunk, 1, sizeof (chunk), in)) > 0) {
+      ok = gzwrite (out, chunk, static_cast<unsigned> (got)) == static_cast<int> (got);
+    }
+    ok = !std::ferror (in) && gzclose (out) == Z_OK && ok;
+    std::fclose (in);
+
+    std::error_code error;
+    std::filesystem::remove (ok ? from : to, error);
+    return ok;
+  }
+
+  std::chrono::system_clock::time_point toSystemTime (std::filesystem::file_time_type time) {
+    return std::chrono::system_clock::now ()
+           + std::chrono::duration_cast<std::chrono::system_clock::duration> (
+               time - std::filesystem::file_time_type::clock::now ());
+  }
+} // namespace
+
+bool RotatingFile::open (const std::filesystem::path& path, const Policy& policy) {
+  close ();
+  path_ = path;
+  policy_ = policy;
+  file_ = std::fopen (path_.string ().c_str (), "ab");
+  if (!file_) {
+    return false;
+  }
+  // the buffer below is the only one
+  std::setvbuf (file_, nullptr, _IONBF, 0);
+  std::error_code error;
+  const std::uintmax_t size = std::filesystem::file_size (path_, error);
+  size_ = error ? 0 : size;
+  buffer_.reserve (policy_.bufferBytes);
+  // a file kept over a restart is as old as the last rotation, the time the newest rotated
+  // file was last written; without one, as old as its own last write
+  openedAt_ = std::chrono::system_clock::now ();
+  if (size_ != 0) {
+    std::filesystem::file_time_type modified
+        = std::filesystem::last_write_time (rotatedPath (1), error);
+    if (error) {
+      modified = std::filesystem::last_write_time (path_, error);
+    }
+    if (!error) {
+      openedAt_ = std::min (openedAt_, toSystemTime (modified));
+    }
+  }
+  syncedAt_ = std::chrono::steady_clock::now ();
+  return true;
+}
+
+void RotatingFile::close () {
+  if (!file_) {
+    return;
+  }
+  flush ();
+  std::fclose (file_);
+  file_ = nullptr;
+}
+
+bool RotatingFile::write (std::string_view data) {
+  if (!file_) {
+    return false;
+  }
+  const std::uint64_t pending = size_ + buffer_.size ();
+  const bool full = policy_.maxBytes != 0 && pending != 0
+                    && pending + data.size () > policy_.maxBytes;
+  const bool old = policy_.maxAge.count () > 0
+                   && std::chrono::system_clock::now () - openedAt_ >= policy_.maxAge;
+  if ((full || old) && !rotate ()) {
+    return false;
+  }
+
+  if (buffer_.size () + data.size () > policy_.bufferBytes && !flush ()) {
+    return false;
+  }
+  // a record larger than the whole buffer goes straight out
+  if (data.size () > policy_.bufferBytes) {
+    return writeOut (data.data (), data.size ());
+  }
+  buffer_.append (data);
+  return true;
+}
+
+bool RotatingFile::flush () {
+  if (!file_) {
+    return false;
+  }
+  const bool ok = writeOut (buffer_.data (), buffer_.size ());
+  buffer_.clear ();
+  const auto now = std::chrono::steady_clock::now ();
+  if (policy_.fsyncInterval.count () >= 0 && now - syncedAt_ >= policy_.fsyncInterval) {
+#ifdef _WIN32
+    _commit (_fileno (file_));
+#else
+    ::fsync (fileno (file_));
+#endif
+    syncedAt_ = now;
+  }
+  return ok;
+}
+
+bool RotatingFile::writeOut (const char* data, std::size_t size) {
+  if (size == 0) {
+    return true;
+  }
+  const std::size_t written = std::fwrite (data, 1, size, file_);
+  size_ += written;
+  return written == size;
+}
+
+std::filesystem::path RotatingFile::rotatedPath (std::size_t index) const {
+  std::filesystem::path rotated = path_;
+  rotated += "." + std::to_string (index) + (policy_.gzip ? ".gz" : "");
+  return rotated;
+}
+
+bool RotatingFile::rotate () {
+  flush ();
+  std::fclose (file_);
+  file_ = nullptr;
+
+  std::error_code error;
+  if (policy_.retain == 0) {
+    std::filesystem::remove (path_, error);
+  } else {
+    std::filesystem::remove (rotatedPath (policy_.retain), error);
+    for (std::size_t index = policy_.retain - 1; index > 0; --index) {
+      if (std::filesystem::exists (rotatedPath (index), error)) {
+        std::filesystem::rename (rotatedPath (index), rotatedPath (index + 1), error);
+      }
+    }
+    if (policy_.gzip) {
+      std::filesystem::path plain = path_;
+      plain += ".1";
+      std::filesystem::rename (path_, plain, error);
+      // the retention never sees a plain .1 next to the .N.gz ones, it is not kept
+      if (!error && !gzipFile (plain, rotatedPath (1))) {
+        std::cerr << "Failed to compress rotated log file, removing it: " << plain << std::endl;
+        std::filesystem::remove (plain, error);
+      }
+    } else {
+      std::filesystem::rename (path_, rotatedPath (1), error);
+    }
+  }
+  if (error) {
+    std::cerr << "Failed to rotate log file: " << path_ << " - " << error.message ()
+              << std::endl;
+  }
+
+  const Policy policy = policy_;
+  return open (path_, policy);
+}
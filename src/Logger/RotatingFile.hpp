@@ -0,0 +1,69 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Log file that rotates by size and age
+
+#ifndef ROTATINGFILE_HPP
+#define ROTATINGFILE_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+// Append-only log file written through its own buffer and rotated when it
+// grows over maxBytes or gets older than maxAge: name.log becomes name.log.1
+// (name.log.1.gz with gzip), older ones shift up and the ones over retain are
+// deleted. Not thread safe, Logger writes it under its mutex.
+class RotatingFile {
+public:
+  struct Policy {
+    // 0 for no limit
+    std::uint64_t maxBytes = 0;
+    // counted from the last rotation, also when the file is opened again after a restart
+    std::chrono::seconds maxAge{ 0 };
+    // rotated files kept next to the current one
+    std::size_t retain = 5;
+    bool gzip = false;
+    // written to the file once this fills up or on flush ()
+    std::size_t bufferBytes = 64 * 1024;
+    // fsync after a flush at most this often, never when negative
+    std::chrono::milliseconds fsyncInterval{ -1 };
+  };
+
+  RotatingFile () = default;
+  ~RotatingFile () {
+    close ();
+  }
+  RotatingFile (const RotatingFile&) = delete;
+  RotatingFile& operator= (const RotatingFile&) = delete;
+
+  bool open (const std::filesystem::path& path, const Policy& policy);
+  bool is_open () const {
+    return file_ != nullptr;
+  }
+  void close ();
+
+  // Rotates first when data would take the file over a limit
+  bool write (std::string_view data);
+  // Hands the buffer to the OS, fsyncs when the policy says so
+  bool flush ();
+
+  // path.N, or path.N.gz with gzip
+  std::filesystem::path rotatedPath (std::size_t index) const;
+
+private:
+  bool rotate ();
+  bool writeOut (const char* data, std::size_t size);
+
+  std::filesystem::path path_;
+  Policy policy_;
+  std::FILE* file_ = nullptr;
+  std::string buffer_;
+  std::uint64_t size_ = 0;
+  std::chrono::system_clock::time_point openedAt_{};
+  std::chrono::steady_clock::time_point syncedAt_{};
+};
+
+#endif // ROTATINGFILE_HPP
@@ -1,33 +1,42 @@
 // MIT License
 // Copyright (c) 2024-2025 Tomáš Mark
 
+#include <Bible/VerseIndex.hpp>
+#include <Bible/VerseSearch.hpp>
+#include <Discord/CommandLatency.hpp>
+#include <Discord/SendQueue.hpp>
+#include <Cache/TtlCache.hpp>
+#include <Http/AsyncHttpClient.hpp>
+#include <Http/HttpClient.hpp>
+#include <Http/ValidatorStore.hpp>
 #include <Logger/Logger.hpp>
 #include <MyDpp/MyDpp.hpp>
+#include <Rss/FeedAggregator.hpp>
+#include <Rss/FeedStore.hpp>
+#include <Rss/RssStreamParser.hpp>
+#include <Scheduler/ChannelJobs.hpp>
+#include <Scheduler/Scheduler.hpp>
+#include <Scheduler/WorkerPool.hpp>
+#include <System/Subprocess.hpp>
+#include <System/SystemInfo.hpp>
 #include <Utils/Utils.hpp>
 
-#include <curl/curl.h>
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <array>
 #include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <future>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
 #include <string>
-#include <thread>
-
-#include "tinyxml2.h"
-
-// TODO
-// pooling required better design pattern
-
-#ifdef _WIN32
-  #include <cstdio>
-  #define popen _popen
-  #define pclose _pclose
-#else
-  #include <cstdio>
-#endif
+#include <string_view>
+#include <unordered_map>
+#include <utility>
 
 #define EMOJI_INTERVAL_SEC (int)10
 
@@ -41,38 +50,490 @@
   "https://www.cnb.cz/cs/financni-trhy/devizovy-trh/kurzy-devizoveho-trhu/" \
   "kurzy-devizoveho-trhu/denni_kurz.txt"
 
+#define URL_ROOT_CZ_RSS "https://www.root.cz/rss/clanky/"
+#define ROOT_CZ_FEED_CAPACITY (std::size_t)64
+
 const dpp::snowflake channelDev = 1327591560065449995;
 
-std::atomic<bool> isRefreshSunrisetRunning (false);
-#define REGULAR_REFRESH_SUNRISET_MESSAGE_INTERVAL_SEC (int)43200 * 2 // 24 hours
-std::atomic<bool> stopRefreshSunriset (false);
+#define SCHEDULER_WORKERS (std::size_t)2
 
-std::atomic<bool> isRefreshEmojiesRunning (false);
-#define REGULAR_REFRESH_EMOJIES_MESSAGE_INTERVAL_SEC (int)10 // CCA 3 hours
-std::atomic<bool> stopRefreshEmojies (false);
+#define COMMAND_WORKERS (std::size_t)4
 
-#define REGULAR_REFRESH_MESSAGE_INTERVAL_SEC (int)10800 // 3 hours
-std::atomic<bool> stopRefreshMessageThread (false);
+#define SYSTEM_INFO_TTL_SEC (int)5
 
-#define BITCOIN_PRICE_MESSAGE_INTERVAL_SEC (int)43200 * 2 // 24 hours
-std::atomic<bool> stopGetBitcoinPrice (false);
+#define SUBPROCESS_TIMEOUT_MS (int)2000
 
-#define GITHUB_INFO_MESSAGE_INTERVAL_SEC (int)43200 // 12 hours
-std::atomic<bool> stopGetGithubInfo (false);
+// Discord drops an interaction not acknowledged within 3 seconds
+#define INTERACTION_DEADLINE_MS (int)3000
 
-#define CZECH_EXCHANGERATES_MESSAGE_INTERVAL_SEC (int)43200 * 2 // 24 hours
-std::atomic<bool> stopGetCzechExchangeRates (false);
+#define REGULAR_REFRESH_EMOJIES_MESSAGE_INTERVAL_SEC (int)10
+
+#define GITHUB_INFO_MESSAGE_INTERVAL_SEC (int)43200 // 12 hours
 
 #define GITHUB_EVENT_POLLING_INTERVAL_SEC (int)10
-std::atomic<bool> stopGithubEventPooling (false);
 
-std::atomic<bool> isGetBibleVerseRunning (false);
-#define CZECH_BIBLE_VERSE_POLLING_INTERVAL_SEC (int)43200 // 12 hours
-std::atomic<bool> stopGetCzechBibleVersePooling (false);
+#define CHANNEL_JOBS_TICK_SEC (int)10
+
+#define SHUTDOWN_TIMEOUT_MS (int)5000
+
+// "<application id> <hash>" of the slash commands Discord last accepted
+#define COMMANDS_HASH_FILE "commands.hash"
+
+#define DISCORD_MAX_MESSAGE_SIZE (std::size_t)2000
+
+#define FEEDS_POLLING_INTERVAL_SEC (int)600 // 10 minutes
+#define FEEDS_POLLING_JITTER_SEC (int)30
+#define FEEDS_MAX_IN_FLIGHT (std::size_t)16
+#define FEEDS_TIMELINE_ITEMS (std::size_t)30
 
 namespace dotname {
 
-  MyDpp::MyDpp () {
+  struct MyDpp::BodyStream {
+    HttpClient::Sink sink;
+    // message once the whole body went through sink
+    std::function<std::string ()> finish;
+  };
+
+  struct MyDpp::Command {
+    const char* name;
+    const char* description;
+    // adds the options, nullptr when there are none
+    void (*options) (dpp::slashcommand& command);
+    // replies itself, quick commands and those deferring on their own
+    void (*handler) (MyDpp& bot, const dpp::slashcommand_t& event);
+    // slow answer computed on the command pool behind a thinking reply, instead of handler
+    std::string (*answer) (MyDpp& bot, const dpp::slashcommand_t& event) = nullptr;
+
+    static const Command table[];
+    // O(1) lookup by name, nullptr for an unknown command
+    static const Command* find (std::string_view name);
+  };
+
+  struct MyDpp::DataSource {
+    const char* url;
+    TtlCache<std::string>::Policy policy;
+    // either the whole body is formatted or it is streamed while downloading
+    std::string (MyDpp::*format) (const std::string& body);
+    std::shared_ptr<BodyStream> (MyDpp::*stream) ();
+    const char* error;
+    // fetched with If-None-Match / If-Modified-Since, a 304 skips transfer and parsing
+    bool conditional;
+
+    HttpClient::Validators validators (const MyDpp& bot) const;
+    std::shared_ptr<BodyStream> open (MyDpp& bot) const;
+    // Turns response into message, false when there is nothing new to serve
+    bool read (MyDpp& bot, const HttpClient::Response& response, BodyStream* body,
+               std::string& message) const;
+
+    static const DataSource bitcoin;
+    static const DataSource exchangeRate;
+    static const DataSource rootcz;
+  };
+
+  using namespace std::chrono_literals;
+
+  namespace {
+    // Jobs a channel can subscribe, in the order of channelJobNames
+    enum ChannelJob : ChannelJobs::Job { JobVerse, JobBitcoin, JobExchangeRate, JobSunriset,
+                                         JobFortune };
+    const char* const channelJobNames[] = { "verse", "btc", "czk", "sunriset", "fortune" };
+
+    // Subscriptions of channelDev when there is no assets/jobs.txt
+    const std::pair<ChannelJob, const char*> defaultChannelJobs[] = {
+      { JobSunriset, "06:00" }, { JobVerse, "12h" },        { JobFortune, "3h" },
+      { JobBitcoin, "1d" },     { JobExchangeRate, "14:45" }
+    };
+
+    MyDpp::RSSItem toRSSItem (const RssStreamParser::Item& item) {
+      return MyDpp::RSSItem (std::string (item.title), std::string (item.link),
+                             std::string (item.description), std::string (item.pubDate),
+                             std::string (item.guid));
+    }
+
+    // Appends "[title](link)" to message, false when it would not fit one Discord message
+    template <typename Item> bool appendLink (std::string& message, const Item& item) {
+      std::string msg = "[" + item.title + "](" + item.link + ")\n";
+      if (msg.size () + message.size () >= 2000) {
+        return false;
+      }
+      message += msg;
+      return true;
+    }
+
+    // At most maxBytes of text, never cut inside a UTF-8 sequence
+    std::string_view utf8Prefix (std::string_view text, std::size_t maxBytes) {
+      if (text.size () <= maxBytes) {
+        return text;
+      }
+      std::size_t end = maxBytes;
+      while (end > 0 && (static_cast<unsigned char> (text[end]) & 0xC0) == 0x80) {
+        --end;
+      }
+      return text.substr (0, end);
+    }
+
+    // Rate limit headers of a D++ answer, the parsed fields when a header is missing
+    SendQueue::Answer toAnswer (const dpp::http_request_completion_t& http) {
+      auto header = [&http] (const char* name, double fallback) {
+        auto it = http.headers.find (name);
+        return it != http.headers.end () ? std::strtod (it->second.c_str (), nullptr) : fallback;
+      };
+      const bool limited = http.ratelimit_limit != 0;
+      SendQueue::Answer answer;
+      answer.status = http.status;
+      answer.remaining = static_cast<int> (header (
+          "x-ratelimit-remaining", limited ? static_cast<double> (http.ratelimit_remaining) : -1));
+      answer.resetAfter = header ("x-ratelimit-reset-after",
+                                  limited ? static_cast<double> (http.ratelimit_reset_after) : -1);
+      answer.retryAfter
+          = header ("retry-after", http.ratelimit_retry_after != 0
+                                       ? static_cast<double> (http.ratelimit_retry_after)
+                                       : -1);
+      answer.global = http.ratelimit_global || http.headers.count ("x-ratelimit-global") != 0;
+      return answer;
+    }
+
+    // FNV-1a over the JSON Discord gets, unlike std::hash the same in every build
+    std::uint64_t commandsHash (const std::vector<dpp::slashcommand>& commands) {
+      std::uint64_t hash = 14695981039346656037ull;
+      for (const dpp::slashcommand& command : commands) {
+        for (char c : command.build_json (false) + '\n') {
+          hash = (hash ^ static_cast<unsigned char> (c)) * 1099511628211ull;
+        }
+      }
+      return hash;
+    }
+
+    // $XDG_STATE_HOME/mydpp/file, ~/.local/state/mydpp/file or file in the working
+    // directory; the assets may be installed read-only
+    std::filesystem::path statePath (const char* file) {
+      std::filesystem::path dir;
+      if (const char* state = std::getenv ("XDG_STATE_HOME"); state && *state) {
+        dir = std::filesystem::path (state) / "mydpp";
+      } else if (const char* home = std::getenv ("HOME"); home && *home) {
+        dir = std::filesystem::path (home) / ".local" / "state" / "mydpp";
+      }
+      std::error_code error;
+      if (dir.empty () || (!std::filesystem::create_directories (dir, error) && error)) {
+        return file;
+      }
+      return dir / file;
+    }
+
+    bool isRegistered (const std::filesystem::path& path, dpp::snowflake application,
+                       std::uint64_t hash) {
+      std::ifstream file (path);
+      std::uint64_t storedApplication = 0;
+      std::uint64_t storedHash = 0;
+      return file >> storedApplication >> storedHash && storedApplication == application
+             && storedHash == hash;
+    }
+
+    // One message per channel and as few messages as the 2000 character limit allows
+    template <typename Send>
+    void postFeedItems (const Send& send, const std::vector<FeedAggregator::Post>& posts) {
+      std::vector<std::pair<FeedAggregator::Channel, std::string> > messages;
+      for (const FeedAggregator::Post& post : posts) {
+        auto it = std::find_if (messages.begin (), messages.end (),
+                                [&post] (const auto& m) { return m.first == post.channel; });
+        if (it == messages.end ()) {
+          it = messages.insert (messages.end (), { post.channel, std::string () });
+        }
+        if (!appendLink (it->second, post.item)) {
+          send (dpp::message (it->first, it->second));
+          it->second.clear ();
+          appendLink (it->second, post.item);
+        }
+      }
+      for (const auto& [channel, message] : messages) {
+        if (!message.empty ()) {
+          send (dpp::message (channel, message));
+        }
+      }
+    }
+  } // namespace
+
+  // ttl: served as it is, stale: served while one refresh runs in the background
+  const MyDpp::DataSource MyDpp::DataSource::bitcoin{ URL_COIN_GECKO,
+                                                      { 60s, 15min },
+                                                      &MyDpp::formatBitcoinPrice,
+                                                      nullptr,
+                                                      "Error: Could not get the Bitcoin price!",
+                                                      false };
+  // CNB publishes the rates once a working day
+  const MyDpp::DataSource MyDpp::DataSource::exchangeRate{
+    URL_EXCHANGE_RATES_CZ,
+    { 1h, 24h },
+    &MyDpp::formatCzechExchangeRate,
+    nullptr,
+    "Error: Could not get the Czech exchange rate!",
+    true
+  };
+  const MyDpp::DataSource MyDpp::DataSource::rootcz{ URL_ROOT_CZ_RSS,
+                                                     { 5min, 30min },
+                                                     nullptr,
+                                                     &MyDpp::streamRootcz,
+                                                     "Error: Could not get the RSS feed!",
+                                                     true };
+
+  HttpClient::Validators MyDpp::DataSource::validators (const MyDpp& bot) const {
+    return conditional ? bot.validators_->get (url) : HttpClient::Validators{};
+  }
+
+  std::shared_ptr<MyDpp::BodyStream> MyDpp::DataSource::open (MyDpp& bot) const {
+    return stream ? (bot.*stream) () : nullptr;
+  }
+
+  bool MyDpp::DataSource::read (MyDpp& bot, const HttpClient::Response& response,
+                                BodyStream* body, std::string& message) const {
+    if (response.notModified ()) {
+      // the cached message was formatted from the very same body
+      if (bot.responseCache_->peek (url, message)) {
+        return true;
+      }
+      bot.validators_->forget (url);
+      return false;
+    }
+    if (!response.ok ()) {
+      return false;
+    }
+
+    try {
+      message = body ? body->finish () : (bot.*format) (response.body);
+    } catch (const std::exception& e) {
+      LOG_E_STREAM << "Error: " << e.what () << std::endl;
+      return false;
+    }
+    // an empty message is a parse failure, keep serving the last good one
+    if (message.empty ()) {
+      return false;
+    }
+    if (conditional) {
+      bot.validators_->update (url, response);
+    }
+    return true;
+  }
+
+  namespace {
+    void addJobChoices (dpp::command_option& option) {
+      for (const char* name : channelJobNames) {
+        option.add_choice (dpp::command_option_choice (name, std::string (name)));
+      }
+    }
+  } // namespace
+
+  // Slash commands in the order they are registered
+  const MyDpp::Command MyDpp::Command::table[] = {
+    { "sunriset", "Get sunriset!", nullptr,
+      [] (MyDpp& bot, const dpp::slashcommand_t& event) {
+        std::string message = bot.getSunriset ();
+        dpp::message msg (channelDev, message);
+        event.reply (msg);
+      } },
+    { "verse", "Get verse from Czech Bible!",
+      [] (dpp::slashcommand& command) {
+        command.add_option (dpp::command_option (dpp::co_string, "ref",
+                                                 "Verses by reference, e.g. Jan 3:16-18", false));
+        command.add_option (dpp::command_option (dpp::co_string, "search",
+                                                 "Find verses containing all the words", false));
+      },
+      [] (MyDpp& bot, const dpp::slashcommand_t& event) {
+        dpp::command_value ref = event.get_parameter ("ref");
+        if (std::holds_alternative<std::string> (ref)) {
+          event.reply (bot.getVerses (std::get<std::string> (ref)));
+          return;
+        }
+        dpp::command_value search = event.get_parameter ("search");
+        if (std::holds_alternative<std::string> (search)) {
+          event.reply (bot.searchCzechBibleVerses (std::get<std::string> (search)));
+          return;
+        }
+        std::string message = bot.getCzechBibleVerse ();
+        dpp::message msg (channelDev, message);
+        event.reply (msg);
+      } },
+    { "czk", "Get Czech Exchange!", nullptr,
+      [] (MyDpp& bot, const dpp::slashcommand_t& event) {
+        bot.replyWhenFetched (event, DataSource::exchangeRate);
+      } },
+    { "btc", "Get Bitcoin Price!", nullptr,
+      [] (MyDpp& bot, const dpp::slashcommand_t& event) {
+        bot.replyWhenFetched (event, DataSource::bitcoin);
+      } },
+    { "fortune", "Get random Quote!", nullptr, nullptr,
+      [] (MyDpp& bot, const dpp::slashcommand_t& event) {
+        return "Quote\n\t" + bot.getLinuxFortuneCpp ();
+      } },
+    { "noemojies", "Stop to getting random Emoji in regularly interval 10 seconds!", nullptr,
+      [] (MyDpp& bot, const dpp::slashcommand_t& event) {
+        if (!bot.stopPollingEmojies ()) {
+          dpp::message msg (channelDev, "Emojies are already stopped! 🛑");
+          event.reply (msg);
+          return;
+        }
+        event.reply ("Emojies are stopped! 🛑");
+      } },
+    { "emojies", "Get random Emoji in regularly interval 10 seconds!", nullptr,
+      [] (MyDpp& bot, const dpp::slashcommand_t& event) {
+        if (!bot.startPollingEmojies ()) {
+          dpp::message msg (channelDev, "Emojies already running! 🕒");
+          event.reply (msg);
+          return;
+        }
+        event.reply ("Emojies are being sent in regularly interval 10 seconds! 🕒");
+      } },
+    { "emoji", "Get random Emoji!", nullptr,
+      [] (MyDpp& bot, const dpp::slashcommand_t& event) {
+        std::string buf = bot.emojiTools->getRandomEmoji ();
+        LOG_I_STREAM << buf << std::endl;
+        event.reply (buf);
+      } },
+    { "rss", "Get rss feed!", nullptr,
+      [] (MyDpp& bot, const dpp::slashcommand_t& event) {
+        // channels with subscriptions get their own timeline, the rest root.cz
+        std::string message;
+        for (const FeedItem& item :
+             bot.feedAggregator_->timeline (event.command.channel_id, FEEDS_TIMELINE_ITEMS)) {
+          if (!appendLink (message, item)) {
+            break;
+          }
+        }
+        if (!message.empty ()) {
+          event.reply (message);
+        } else {
+          bot.replyWhenFetched (event, DataSource::rootcz);
+        }
+      } },
+    { "subscribe", "Post a job to this channel regularly!",
+      [] (dpp::slashcommand& command) {
+        dpp::command_option job (dpp::co_string, "job", "Job posted to this channel", true);
+        addJobChoices (job);
+        command.add_option (job);
+        command.add_option (dpp::command_option (dpp::co_string, "schedule",
+                                                 "Every 30m, 12h, 1d or daily at 06:00", true));
+        command.set_default_permissions (dpp::p_manage_channels);
+      },
+      [] (MyDpp& bot, const dpp::slashcommand_t& event) {
+        ChannelJobs::Job job = 0;
+        ChannelJobs::Schedule schedule;
+        dpp::command_value name = event.get_parameter ("job");
+        dpp::command_value when = event.get_parameter ("schedule");
+        if (!std::holds_alternative<std::string> (name)
+            || !bot.channelJobs_->find (std::get<std::string> (name), job)) {
+          event.reply ("Unknown job! 🛑");
+          return;
+        }
+        if (!std::holds_alternative<std::string> (when)
+            || !ChannelJobs::parseSchedule (std::get<std::string> (when), schedule)) {
+          event.reply ("Schedule is e.g. 30m, 12h, 1d or 06:00, at least 5m 🕒");
+          return;
+        }
+        bot.channelJobs_->subscribe (event.command.channel_id, job, schedule,
+                                     std::time (nullptr));
+        event.reply (fmt::format ("Subscribed {} {} 🕒", bot.channelJobs_->name (job),
+                                  ChannelJobs::formatSchedule (schedule)));
+      } },
+    { "unsubscribe", "Stop posting a job to this channel!",
+      [] (dpp::slashcommand& command) {
+        dpp::command_option job (dpp::co_string, "job", "Job to stop, all when omitted", false);
+        addJobChoices (job);
+        command.add_option (job);
+        command.set_default_permissions (dpp::p_manage_channels);
+      },
+      [] (MyDpp& bot, const dpp::slashcommand_t& event) {
+        ChannelJobs::Job job = 0;
+        dpp::command_value name = event.get_parameter ("job");
+        if (!std::holds_alternative<std::string> (name)) {
+          std::size_t removed = bot.channelJobs_->unsubscribeAll (event.command.channel_id);
+          event.reply (fmt::format ("Unsubscribed {} jobs 🛑", removed));
+          return;
+        }
+        if (!bot.channelJobs_->find (std::get<std::string> (name), job)
+            || !bot.channelJobs_->unsubscribe (event.command.channel_id, job)) {
+          event.reply ("Job is not subscribed here! 🛑");
+          return;
+        }
+        event.reply ("Unsubscribed " + bot.channelJobs_->name (job) + " 🛑");
+      } },
+    { "subscriptions", "Jobs posted to this channel!", nullptr,
+      [] (MyDpp& bot, const dpp::slashcommand_t& event) {
+        std::string message;
+        for (const auto& [job, schedule] : bot.channelJobs_->jobsOf (event.command.channel_id)) {
+          message += fmt::format ("{} {}\n", bot.channelJobs_->name (job),
+                                  ChannelJobs::formatSchedule (schedule));
+        }
+        event.reply (message.empty () ? "No jobs subscribed here" : message);
+      } },
+    { "ping", "Ping pong!", nullptr,
+      [] (MyDpp& bot, const dpp::slashcommand_t& event) { event.reply ("Pong! 🏓"); } },
+    { "pong", "Pong ping!", nullptr,
+      [] (MyDpp& bot, const dpp::slashcommand_t& event) { event.reply ("Ping! 🏓"); } },
+    { "gang", "Will shoot!", nullptr,
+      [] (MyDpp& bot, const dpp::slashcommand_t& event) {
+        dpp::message msg (event.command.channel_id, "Bang bang! 💥💥");
+        event.reply (msg);
+        bot.postMessage (msg, true);
+      } },
+    { "stopbot", "Stop DSDotBot Bot!", nullptr,
+      [] (MyDpp& bot, const dpp::slashcommand_t& event) {
+        dpp::message msgFastfetch (channelDev, "stoping bot ...\n");
+        event.reply (msgFastfetch);
+        // jobs stop, sent messages are delivered, then D++ stops
+        bot.requestShutdown ();
+      } },
+    { "bot", "About DSDotBot Bot!", nullptr,
+      [] (MyDpp& bot, const dpp::slashcommand_t& event) {
+        dpp::message msgFastfetch (channelDev,
+                                   bot.getLinuxFastfetchCpp ().substr (0, 8192 - 2) + "\n");
+        event.reply (msgFastfetch);
+      } },
+  };
+
+  const MyDpp::Command* MyDpp::Command::find (std::string_view name) {
+    static const std::unordered_map<std::string_view, const Command*> byName = [] {
+      std::unordered_map<std::string_view, const Command*> commands;
+      for (const Command& command : table) {
+        commands.emplace (command.name, &command);
+      }
+      return commands;
+    }();
+    auto it = byName.find (name);
+    return it == byName.end () ? nullptr : it->second;
+  }
+
+  MyDpp::MyDpp ()
+      : httpClient_ (std::make_unique<dotname::HttpClient> ()),
+        asyncHttpClient_ (std::make_unique<dotname::AsyncHttpClient> ()),
+        responseCache_ (std::make_unique<ResponseCache> ()),
+        validators_ (std::make_unique<dotname::ValidatorStore> ()),
+        rootczFeed_ (std::make_unique<dotname::FeedStore<RSSItem> > (ROOT_CZ_FEED_CAPACITY)),
+        feedAggregator_ (
+            std::make_unique<dotname::FeedAggregator> (*asyncHttpClient_, FEEDS_MAX_IN_FLIGHT)),
+        channelJobs_ (std::make_unique<dotname::ChannelJobs> (std::vector<std::string> (
+            std::begin (channelJobNames), std::end (channelJobNames)))),
+        sendQueue_ (std::make_unique<dotname::SendQueue> (
+            [this] (SendQueue::Channel channel, const std::string& content,
+                    SendQueue::Answered answered) {
+              if (!m_bot) {
+                answered (SendQueue::Answer{});
+                return;
+              }
+              m_bot->message_create (
+                  dpp::message (channel, content),
+                  [answered] (const dpp::confirmation_callback_t& callback) {
+                    if (callback.is_error ()) {
+                      LOG_E_STREAM << "Error: " << callback.get_error ().message << std::endl;
+                    }
+                    answered (toAnswer (callback.http_info));
+                  });
+            },
+            DISCORD_MAX_MESSAGE_SIZE)),
+        scheduler_ (std::make_unique<dotname::Scheduler> (SCHEDULER_WORKERS)),
+        commandPool_ (std::make_unique<dotname::WorkerPool> (COMMAND_WORKERS)),
+        commandLatency_ (std::make_unique<dotname::CommandLatency> ()),
+        // host, OS, kernel and CPU are read here once, before the first /bot
+        systemInfo_ (std::make_unique<dotname::SystemInfo> (
+            "/", std::chrono::seconds (SYSTEM_INFO_TTL_SEC))) {
     LOG_D_STREAM << libName << " ...constructed" << std::endl;
     if (!assetsPath_.empty ()) {
       LOG_D_STREAM << "Assets path: " << assetsPath_ << std::endl;
@@ -86,9 +547,44 @@ namespace dotname {
     this->emojiTools = std::make_shared<dotname::EmojiTools> (assetsPath_);
     this->sunrisetTools = std::make_shared<dotname::Sunriset> ();
 
+    // Kralice Bible is mapped and indexed once, verses are served from the offset table
+    this->verseIndex_ = std::make_unique<dotname::VerseIndex> ();
+    if (!verseIndex_->load (assetsPath_ / "kralicky.txt")) {
+      LOG_E_STREAM << "Error: Could not index kralicky.txt" << std::endl;
+    }
+    this->verseSearch_ = std::make_unique<dotname::VerseSearch> ();
+    if (verseIndex_->isLoaded () && !verseSearch_->build (*verseIndex_)) {
+      LOG_E_STREAM << "Error: Could not build verse search index" << std::endl;
+    }
+
+    const std::filesystem::path feeds = assetsPath_ / "feeds.txt";
+    if (!std::filesystem::exists (feeds) || !feedAggregator_->load (feeds)) {
+      feedAggregator_->subscribe (channelDev, URL_ROOT_CZ_RSS);
+    }
+    LOG_I_STREAM << "Subscribed " << feedAggregator_->feedCount () << " feeds" << std::endl;
+
+    const std::filesystem::path jobs = assetsPath_ / "jobs.txt";
+    if (!std::filesystem::exists (jobs) || !channelJobs_->load (jobs, std::time (nullptr))) {
+      for (const auto& [job, when] : defaultChannelJobs) {
+        ChannelJobs::Schedule schedule;
+        ChannelJobs::parseSchedule (when, schedule);
+        channelJobs_->subscribe (channelDev, job, schedule, std::time (nullptr));
+      }
+    }
+    LOG_I_STREAM << "Subscribed " << channelJobs_->size () << " channel jobs" << std::endl;
+
     this->initCluster ();
   }
   MyDpp::~MyDpp () {
+    if (stopper_.joinable ()) {
+      stopper_.join ();
+    }
+    shutdown (std::chrono::milliseconds (SHUTDOWN_TIMEOUT_MS));
+    // jobs and deferred commands use everything below, they stop first
+    scheduler_.reset ();
+    commandPool_.reset ();
+    // aborted fetches still answer their interactions, the cluster has to outlive them
+    asyncHttpClient_.reset ();
     LOG_D_STREAM << libName << " ...destructed" << std::endl;
   }
 
@@ -113,15 +609,12 @@ namespace dotname {
 
         std::string message = this->getEnvironmentInfo ();
         dpp::message msg (channelDev, message);
-        m_bot->message_create (msg);
+        postMessage (msg);
         LOG_I_STREAM << message << std::endl;
 
         welcomeWithFastfetch ();
-        startPollingFortune ();
-        startPollingBTCPrice ();
-        startPollingCZExchRate ();
-        startPollingGetBibleVerse ();
-        startPollingSunriset ();
+        startPollingChannelJobs ();
+        startPollingFeeds ();
         loadVariousBotCommands ();
 
         m_bot->start (dpp::st_wait);
@@ -135,17 +628,75 @@ namespace dotname {
     return true;
   }
 
+  bool MyDpp::shutdown (std::chrono::milliseconds timeout) {
+    std::lock_guard<std::mutex> lock (shutdownMutex_);
+    if (isShutdown_) {
+      return true;
+    }
+    isShutdown_ = true;
+    LOG_I_STREAM << "Shutting down " << libName << " ..." << std::endl;
+
+    const auto deadline = std::chrono::steady_clock::now () + timeout;
+    // no job starts any more, the running ones see the stop token and return early
+    bool drained = scheduler_->shutdown (timeout);
+    auto left = [&deadline] () {
+      return std::chrono::duration_cast<std::chrono::milliseconds> (
+          std::max (deadline - std::chrono::steady_clock::now (),
+                    std::chrono::steady_clock::duration::zero ()));
+    };
+    // deferred commands being answered finish, the queued ones are dropped
+    drained = commandPool_->shutdown (left ()) && drained;
+    // messages the jobs and commands already sent are still delivered
+    if (!sendQueue_->shutdown (left ())) {
+      LOG_W_STREAM << "Warning: " << sendQueue_->pending ()
+                   << " Discord messages unsent or unanswered at shutdown" << std::endl;
+      drained = false;
+    }
+    const SendQueue::Stats stats = sendQueue_->stats ();
+    LOG_I_STREAM << "Messages sent " << stats.sent << ", coalesced " << stats.coalesced
+                 << ", rate limited " << stats.rateLimited << ", failed " << stats.failed
+                 << std::endl;
+    for (const auto& [name, latency] : commandLatency_->summaries ()) {
+      LOG_I_STREAM << "/" << name << " answered " << latency.count << "x, p50 "
+                   << latency.p50.count () / 1000 << " ms, p99 " << latency.p99.count () / 1000
+                   << " ms, max " << latency.max.count () / 1000 << " ms" << std::endl;
+    }
+    if (m_bot) {
+      m_bot->shutdown ();
+    }
+    return drained;
+  }
+
+  void MyDpp::requestShutdown () {
+    std::lock_guard<std::mutex> lock (shutdownMutex_);
+    if (isShutdown_ || stopper_.joinable ()) {
+      return;
+    }
+    // event handlers must not wait for the requests they are part of
+    stopper_ = std::thread (
+        [this] () { shutdown (std::chrono::milliseconds (SHUTDOWN_TIMEOUT_MS)); });
+  }
+
+  void MyDpp::postMessage (const dpp::message& msg, bool interaction) {
+    const SendQueue::Lane lane
+        = interaction ? SendQueue::Lane::Interaction : SendQueue::Lane::Scheduled;
+    if (!sendQueue_->push (msg.channel_id, msg.content, lane)) {
+      LOG_W_STREAM << "Warning: Shutting down, message to " << msg.channel_id << " dropped"
+                   << std::endl;
+    }
+  }
+
   std::string MyDpp::getEnvironmentInfo () {
     return std::string ("C++ DSDotBot 🛸🛸🛸 ") + DPP_VERSION_TEXT + " loaded.\n";
   }
 
   bool MyDpp::welcomeWithFastfetch () {
     // DSDotBot loaded
-    m_bot->on_ready ([&] (const dpp::ready_t& event) {
+    m_bot->on_ready ([this] (const dpp::ready_t& event) {
       try {
         dpp::message msgFastfetch (channelDev,
                                    this->getLinuxFastfetchCpp ().substr (0, 8192 - 2) + "\n");
-        m_bot->message_create (msgFastfetch);
+        postMessage (msgFastfetch);
         LOG_I_STREAM << msgFastfetch.content << std::endl;
       } catch (const std::runtime_error& e) {
         LOG_E_STREAM << "Error: " << e.what () << std::endl;
@@ -156,10 +707,10 @@ namespace dotname {
 
   bool MyDpp::welcomeWithNeofetch () {
     // DSDotBot loaded
-    m_bot->on_ready ([&] (const dpp::ready_t& event) {
+    m_bot->on_ready ([this] (const dpp::ready_t& event) {
       try {
         dpp::message msgNeofetch (channelDev, this->getLinuxNeofetchCpp ().substr (0, 1998) + "\n");
-        m_bot->message_create (msgNeofetch);
+        postMessage (msgNeofetch);
         LOG_I_STREAM << msgNeofetch.content << std::endl;
       } catch (const std::runtime_error& e) {
         LOG_E_STREAM << "Error: " << e.what () << std::endl;
@@ -168,138 +719,106 @@ namespace dotname {
     return true;
   }
 
-  bool MyDpp::startPollingSunriset () {
-    {
-      std::thread threadRegularSunriset ([&] () -> void {
-        while (!stopRefreshSunriset.load ()) {
-          try {
-            std::string message = getSunriset ();
-            dpp::message msg (channelDev, message);
-            m_bot->message_create (msg);
-            isRefreshSunrisetRunning.store (true);
-          } catch (const std::runtime_error& e) {
-            LOG_E_STREAM << "Error: " << e.what () << std::endl;
-            isRefreshSunrisetRunning.store (false);
-          }
-          std::this_thread::sleep_for (
-              std::chrono::seconds (REGULAR_REFRESH_SUNRISET_MESSAGE_INTERVAL_SEC));
-        }
-      });
-      threadRegularSunriset.detach ();
+  bool MyDpp::startPollingEmojies () {
+    const Scheduler::JobId job
+        = scheduler_->every (std::chrono::seconds (REGULAR_REFRESH_EMOJIES_MESSAGE_INTERVAL_SEC),
+                             [this] () {
+                               dpp::message msg (channelDev, emojiTools->getRandomEmoji ());
+                               postMessage (msg);
+                             });
+    // the first run is a tick away, a concurrent /emojies that lost is cancelled before it
+    Scheduler::JobId idle = Scheduler::noJob;
+    if (job == Scheduler::noJob) {
+      return false;
     }
-    return true;
-  }
-
-  bool MyDpp::startPollingGetBibleVerse () {
-    {
-      std::thread threadRegularGetBibleVerse ([&] () -> void {
-        while (!stopGetCzechBibleVersePooling.load ()) {
-          try {
-            std::string message = getCzechBibleVerse ();
-            dpp::message msg (channelDev, message);
-            m_bot->message_create (msg);
-            isGetBibleVerseRunning.store (true);
-          } catch (const std::runtime_error& e) {
-            LOG_E_STREAM << "Error: " << e.what () << std::endl;
-            isGetBibleVerseRunning.store (false);
-          }
-          std::this_thread::sleep_for (
-              std::chrono::seconds (CZECH_BIBLE_VERSE_POLLING_INTERVAL_SEC));
-        }
-      });
-      threadRegularGetBibleVerse.detach ();
+    if (!emojiJob_.compare_exchange_strong (idle, job)) {
+      scheduler_->cancel (job);
+      return false;
     }
     return true;
   }
 
-  bool MyDpp::startPollingEmojies () {
-    {
-      std::thread threadRegularRefreshEmojiesMessage ([&] () -> void {
-        while (!stopRefreshEmojies.load ()) {
-          try {
-            std::string message = emojiTools->getRandomEmoji ();
-            // LOG_D << message << std::endl;
-            dpp::message msg (channelDev, message);
-            m_bot->message_create (msg);
-            isRefreshEmojiesRunning.store (true);
-          } catch (const std::runtime_error& e) {
-            LOG_E_STREAM << "Error: " << e.what () << std::endl;
-            isRefreshEmojiesRunning.store (false);
-          }
-
-          std::this_thread::sleep_for (
-              std::chrono::seconds (REGULAR_REFRESH_EMOJIES_MESSAGE_INTERVAL_SEC));
-        }
-      });
-      threadRegularRefreshEmojiesMessage.detach ();
-    }
-    return true;
+  bool MyDpp::stopPollingEmojies () {
+    const Scheduler::JobId job = emojiJob_.exchange (Scheduler::noJob);
+    return job != Scheduler::noJob && scheduler_->cancel (job);
   }
 
-  bool MyDpp::startPollingFortune () {
-    m_bot->on_ready ([&] (const dpp::ready_t& event) {
-      std::thread threadRegularRefreshMessage ([&] () -> void {
-        while (!stopRefreshMessageThread.load ()) {
-          try {
-            std::string message = getLinuxFortuneCpp ();
-            // LOG_D_STREAM << message << std::endl;
-            dpp::message msg (channelDev, "Quote\n\t" + message);
-            m_bot->message_create (msg);
-          } catch (const std::runtime_error& e) {
-            LOG_E_STREAM << "Error: " << e.what () << std::endl;
-          }
-
-          std::this_thread::sleep_for (std::chrono::seconds (REGULAR_REFRESH_MESSAGE_INTERVAL_SEC));
-        }
-      });
-      threadRegularRefreshMessage.detach ();
+  bool MyDpp::startPollingFeeds () {
+    m_bot->on_ready ([this] (const dpp::ready_t& event) {
+      if (!dpp::run_once<struct PollFeeds> ()) {
+        return;
+      }
+      // fetched and parsed on the async HTTP driver, the job only starts the rounds; the
+      // jitter keeps bots started together from hitting the feeds at the same moment
+      scheduler_->every (
+          std::chrono::seconds (FEEDS_POLLING_INTERVAL_SEC),
+          [this] () {
+            const bool started
+                = feedAggregator_->refresh ([this] (std::vector<FeedAggregator::Post>&& posts) {
+                    LOG_D_STREAM << "Feeds refreshed, " << posts.size () << " new items"
+                                 << std::endl;
+                    postFeedItems ([this] (const dpp::message& msg) { postMessage (msg); },
+                                   posts);
+                  });
+            if (!started) {
+              LOG_W_STREAM << "Warning: Previous feed refresh is still running" << std::endl;
+            }
+          },
+          std::chrono::seconds (FEEDS_POLLING_JITTER_SEC));
     });
     return true;
   }
 
-  bool MyDpp::startPollingBTCPrice () {
-    m_bot->on_ready ([&] (const dpp::ready_t& event) {
-      std::thread threadBitcoinPriceMessage ([&] () -> void {
-        while (!stopGetBitcoinPrice.load ()) {
-          try {
-            std::string message = getBitcoinPrice ();
-            // LOG_D_STREAM << message << std::endl;
-            dpp::message msg (channelDev, "\n🪙 " + message);
-            m_bot->message_create (msg);
-          } catch (const std::runtime_error& e) {
-            LOG_E_STREAM << "Error: " << e.what () << std::endl;
-          }
-
-          std::this_thread::sleep_for (std::chrono::seconds (BITCOIN_PRICE_MESSAGE_INTERVAL_SEC));
-        }
+  bool MyDpp::startPollingChannelJobs () {
+    m_bot->on_ready ([this] (const dpp::ready_t& event) {
+      if (!dpp::run_once<struct PollChannelJobs> ()) {
+        return;
+      }
+      // one job serves all subscriptions, a due job builds its message once per tick
+      static_assert (ChannelJobs::minPeriod >= CHANNEL_JOBS_TICK_SEC,
+                     "a subscription is due at most once per tick");
+      scheduler_->every (std::chrono::seconds (CHANNEL_JOBS_TICK_SEC), [this] () {
+        channelJobs_->collect (
+            std::time (nullptr),
+            [this] (ChannelJobs::Job job, const std::vector<ChannelJobs::Channel>& channels) {
+              std::string message;
+              try {
+                message = getChannelJobMessage (job);
+              } catch (const std::runtime_error& e) {
+                LOG_E_STREAM << "Error: " << e.what () << std::endl;
+                return;
+              }
+              const StopToken stop = scheduler_->stopToken ();
+              for (ChannelJobs::Channel channel : channels) {
+                if (stop.stopRequested ()) {
+                  return;
+                }
+                postMessage (dpp::message (channel, message));
+              }
+            });
       });
-      threadBitcoinPriceMessage.detach ();
     });
     return true;
   }
 
-  // TODO Draw as bitmap table will looks better 😎
-  bool MyDpp::startPollingCZExchRate () {
-    m_bot->on_ready ([&] (const dpp::ready_t& event) {
-      std::thread threadCzechExchangeRateMessage ([&] () -> void {
-        while (!stopGetCzechExchangeRates.load ()) {
-          try {
-            std::string message = getCzechExchangeRate ();
-            // LOG_D_STREAM << message << std::endl;
-            dpp::message msg (channelDev, "Czech Exchange Rates 🇨🇿\n" + message);
-            m_bot->message_create (msg);
-          } catch (const std::runtime_error& e) {
-            LOG_E_STREAM << "Error: " << e.what () << std::endl;
-          }
-
-          std::this_thread::sleep_for (
-              std::chrono::seconds (CZECH_EXCHANGERATES_MESSAGE_INTERVAL_SEC));
-        }
-      });
-      threadCzechExchangeRateMessage.detach ();
-    });
-
-    return true;
+  // TODO Draw CZK as bitmap table will looks better 😎
+  std::string MyDpp::getChannelJobMessage (std::uint8_t job) {
+    if (job == JobVerse) {
+      return getCzechBibleVerse ();
+    }
+    if (job == JobBitcoin) {
+      return "\n🪙 " + getBitcoinPrice ();
+    }
+    if (job == JobExchangeRate) {
+      return "Czech Exchange Rates 🇨🇿\n" + getCzechExchangeRate ();
+    }
+    if (job == JobSunriset) {
+      return getSunriset ();
+    }
+    if (job == JobFortune) {
+      return "Quote\n\t" + getLinuxFortuneCpp ();
+    }
+    throw std::runtime_error ("Unknown channel job " + std::to_string (job));
   }
 
   bool MyDpp::getToken (std::string& token, const std::string& filePath) {
@@ -318,173 +837,174 @@ namespace dotname {
   }
 
   std::string MyDpp::getLinuxFortuneCpp () {
-    constexpr size_t bufferSize = 2000;
-    std::stringstream result;
-
-    // Create unique_ptr with custom deleter for RAII
-    std::unique_ptr<FILE, decltype (&pclose)> pipe (popen ("fortune", "r"), pclose);
-    if (!pipe)
+    Subprocess::Options options;
+    options.timeout = std::chrono::milliseconds (SUBPROCESS_TIMEOUT_MS);
+    // room for "Quote\n\t" in one Discord message
+    options.maxBytes = DISCORD_MAX_MESSAGE_SIZE - 16;
+    Subprocess::Result fortune = Subprocess::run ({ "fortune" }, options);
+    if (!fortune.started) {
       throw std::runtime_error ("Failed to run fortune command");
-
-    std::array<char, bufferSize> buffer;
-    while (fgets (buffer.data (), buffer.size (), pipe.get ()) != nullptr) {
-      result << buffer.data ();
-      if (result.str ().size () > bufferSize - 2)
-        break;
     }
-
-    return result.str ();
+    if (fortune.timedOut) {
+      throw std::runtime_error ("fortune command timed out");
+    }
+    return std::move (fortune.output);
   }
 
   std::string MyDpp::getLinuxFastfetchCpp () {
-    constexpr size_t bufferSize = 2000;
-    std::stringstream result;
-
-    // Create unique_ptr with custom deleter for RAII
-    std::unique_ptr<FILE, decltype (&pclose)> pipe (
-        popen ("fastfetch -c archey.jsonc --pipe --logo none", "r"), pclose);
-    if (!pipe)
-      throw std::runtime_error ("Failed to run fastfetch command");
-
-    std::array<char, bufferSize> buffer;
-    while (fgets (buffer.data (), buffer.size (), pipe.get ()) != nullptr) {
-      result << buffer.data ();
-      if (result.str ().size () > bufferSize - 2)
-        break;
-    }
-
-    return result.str ();
+    return systemInfo_->render ();
   }
 
   std::string MyDpp::getLinuxNeofetchCpp () {
-    constexpr size_t bufferSize = 2000;
-    std::stringstream result;
-
-    // Create unique_ptr with custom deleter for RAII
-    std::unique_ptr<FILE, decltype (&pclose)> pipe (popen ("neofetch --stdout", "r"), pclose);
-    if (!pipe)
-      throw std::runtime_error ("Failed to run neofetch command");
-
-    std::array<char, bufferSize> buffer;
-    while (fgets (buffer.data (), buffer.size (), pipe.get ()) != nullptr) {
-      result << buffer.data ();
-      if (result.str ().size () > bufferSize - 2)
-        break;
-    }
-
-    return result.str ();
+    return systemInfo_->render ();
   }
 
-  size_t WriteCallback (void* contents, size_t size, size_t nmemb, void* userp) {
-    ((std::string*)userp)->append ((char*)contents, size * nmemb);
-    return size * nmemb;
+  std::string MyDpp::getBitcoinPrice () {
+    return getCached (DataSource::bitcoin);
   }
 
-  std::string MyDpp::getBitcoinPrice () {
-    CURL* curl;
-    CURLcode res;
-    std::string rawTxtBuffer;
-    curl = curl_easy_init ();
-    if (curl) {
-      curl_easy_setopt (curl, CURLOPT_SSL_VERIFYPEER, 0L); /* temporary - todo cert */
-      curl_easy_setopt (curl, CURLOPT_URL, URL_COIN_GECKO);
-      curl_easy_setopt (curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-      curl_easy_setopt (curl, CURLOPT_WRITEDATA, &rawTxtBuffer);
-
-      res = curl_easy_perform (curl);
-
-      if (res != CURLE_OK) {
-        LOG_E_STREAM << "curl_easy_perform() failed: " << curl_easy_strerror (res) << std::endl;
-      } else {
-        // use lohmann json to parse the response
-        /*
-              {
-                  "bitcoin": {
-                      "usd": 95802
-                  }
+  std::string MyDpp::formatBitcoinPrice (const std::string& body) {
+    // use lohmann json to parse the response
+    /*
+          {
+              "bitcoin": {
+                  "usd": 95802
               }
-              */
+          }
+          */
 
-        nlohmann::json j = nlohmann::json::parse (rawTxtBuffer);
-        std::string usd = j["bitcoin"]["usd"].dump ();
+    nlohmann::json j = nlohmann::json::parse (body);
+    std::string usd = j["bitcoin"]["usd"].dump ();
 
-        LOG_D_STREAM << "Downloaded content:\n" << rawTxtBuffer << std::endl;
-        std::string message = "1 BTC = " + usd + " USD";
-        LOG_I_STREAM << message << std::endl;
+    LOG_D_STREAM << "Downloaded content:\n" << body << std::endl;
+    std::string message = "1 BTC = " + usd + " USD";
+    LOG_I_STREAM << message << std::endl;
 
-        return message;
-      }
+    return message;
+  }
 
-      curl_easy_cleanup (curl);
+  std::string MyDpp::getCzechBibleVerse () {
+    if (!verseIndex_ || !verseIndex_->isLoaded ()) {
+      LOG.error ("Error: Could not open file kralicky.txt");
+      return "Error: Could not get the Czech Bible verse!";
     }
-    return "Error: Could not get the Bitcoin price!";
+
+    int randomIndex = getRandom (0, static_cast<int> (verseIndex_->verseCount ()) - 1);
+    VerseIndex::Verse verse = verseIndex_->verseAt (randomIndex);
+
+    std::string message;
+    message.reserve (sizeof ("📖 ") + verse.heading.size () + verse.text.size () + 2);
+    message.append ("📖 ").append (verse.heading).append ("\n").append (verse.text).append ("\n");
+    return message;
   }
 
-  std::string MyDpp::getCzechBibleVerse () {
-    std::string message = ""; // "📖 Czech Bible Verse 📖\n";
-    std::string bibleChapter;
-    std::string bibleVerse;
-    std::string line;
-    std::ifstream bibleFile (std::string (assetsPath_) + "/" + "kralicky.txt");
-    std::vector<std::pair<std::string, std::string> > bible;
+  std::string MyDpp::getVerse (const std::string& book, int chapter, int verse) {
+    if (!verseIndex_ || !verseIndex_->isLoaded ()) {
+      return "Error: Could not get the Czech Bible verse!";
+    }
+    if (chapter <= 0 || verse <= 0) {
+      return "📖 Verse not found: " + book;
+    }
 
-    try {
-      if (bibleFile.is_open ()) {
-        std::vector<std::string> lines;
-        while (std::getline (bibleFile, line)) {
-          lines.push_back (line);
+    std::size_t id = verseIndex_->findVerse (verseIndex_->findBook (book),
+                                             static_cast<unsigned> (chapter),
+                                             static_cast<unsigned> (verse));
+    if (id == VerseIndex::npos) {
+      return fmt::format ("📖 Verse not found: {} {}:{}", book, chapter, verse);
+    }
+    VerseIndex::Verse found = verseIndex_->verseAt (id);
+    return fmt::format ("📖 {}\n{}\n", found.heading, found.text);
+  }
+
+  std::string MyDpp::getVerses (const std::string& references) {
+    if (!verseIndex_ || !verseIndex_->isLoaded ()) {
+      return "Error: Could not get the Czech Bible verse!";
+    }
+
+    constexpr std::size_t maxMessageSize = 2000;
+    // longer references are shortened in "not found", so the first line always fits
+    constexpr std::size_t maxReferenceShown = 100;
+    std::string message;
+    // false when line would take the message over Discord's limit
+    auto appendLine = [&message] (std::string_view line) {
+      if (message.size () + line.size () + 1 > maxMessageSize) {
+        return false;
+      }
+      message.append (line).append ("\n");
+      return true;
+    };
+    std::string_view rest (references);
+    while (!rest.empty ()) {
+      const std::size_t end = std::min (rest.find (';'), rest.size ());
+      std::string_view reference = rest.substr (0, end);
+      rest.remove_prefix (std::min (end + 1, rest.size ()));
+      while (!reference.empty () && reference.front () == ' ') {
+        reference.remove_prefix (1);
+      }
+      if (reference.empty ()) {
+        continue;
+      }
+
+      std::size_t first = 0;
+      std::size_t count = 0;
+      if (!verseIndex_->findReference (reference, first, count)) {
+        if (!appendLine (fmt::format ("📖 Verse not found: {}",
+                                      utf8Prefix (reference, maxReferenceShown)))) {
+          return message;
         }
-        bibleFile.close ();
-        bibleVerse = lines[0] + "\n";
-        for (int i = 0; i < lines.size (); ++i) {
-          if (!lines[i].empty () && isdigit (lines[i][0])) {
-            bibleVerse = lines[i] + "\n";
-          } else if (lines[i].empty () && (i + 1) < lines.size () && !lines[i + 1].empty ()
-                     && lines[i + 2].empty ()) {
-            bibleChapter = lines[i + 1];
-            bible.push_back (std::make_pair (bibleChapter, bibleVerse));
-          }
+        continue;
+      }
+      if (!appendLine (fmt::format ("📖 {}", verseIndex_->verseAt (first).heading))) {
+        return message;
+      }
+      for (std::size_t id = first; id < first + count; ++id) {
+        if (!appendLine (verseIndex_->verseAt (id).text)) {
+          return message;
         }
-      } else {
-        LOG.error ("Error: Could not open file kralicky.txt");
-        return "Error: Could not get the Czech Bible verse!";
       }
-    } catch (const std::exception& e) {
-      LOG_E_STREAM << e.what () << std::endl;
     }
-
-    int randomIndex = getRandom (0, bible.size () - 1);
-    bibleVerse = bible[randomIndex].second;
-    bibleChapter = bible[randomIndex].first;
-    message += bibleChapter + "\n" + bibleVerse;
-    return "📖 " + message;
+    return message.empty () ? "📖 No reference given" : message;
   }
 
-  std::string MyDpp::getCzechExchangeRate () {
-    CURL* curl;
-    CURLcode res;
-    std::string rawTxtBuffer;
-    curl = curl_easy_init ();
-    if (curl) {
-      curl_easy_setopt (curl, CURLOPT_SSL_VERIFYPEER, 0L); /* temporary - todo cert */
-      curl_easy_setopt (curl, CURLOPT_URL, URL_EXCHANGE_RATES_CZ);
-      curl_easy_setopt (curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-      curl_easy_setopt (curl, CURLOPT_WRITEDATA, &rawTxtBuffer);
+  std::string MyDpp::searchCzechBibleVerses (const std::string& words) {
+    if (!verseSearch_ || !verseSearch_->isBuilt ()) {
+      return "Error: Could not search the Czech Bible!";
+    }
 
-      res = curl_easy_perform (curl);
+    constexpr std::size_t maxVerses = 10;
+    constexpr std::size_t maxMessageSize = 2000;
+    // a string option takes up to 6000 characters, the echo has to fit one message
+    constexpr std::size_t maxQueryShown = 100;
+    std::size_t total = 0;
+    std::vector<std::uint32_t> ids = verseSearch_->find (words, maxVerses, &total);
+    if (ids.empty ()) {
+      return fmt::format ("📖 Nothing found for: {}", utf8Prefix (words, maxQueryShown));
+    }
 
-      if (res != CURLE_OK) {
-        LOG_E_STREAM << "curl_easy_perform() failed: " << curl_easy_strerror (res) << std::endl;
-      } else {
-        // replace char "|" with "\t"
-        std::replace (rawTxtBuffer.begin (), rawTxtBuffer.end (), '|', '\t');
-        // LOG_D_STREAM << "Downloaded content:\n" << rawTxtBuffer << std::endl;
-        return rawTxtBuffer;
+    std::string message = fmt::format ("📖 {} verses found for: {}\n", total,
+                                       utf8Prefix (words, maxQueryShown));
+    for (std::uint32_t id : ids) {
+      VerseIndex::Verse verse = verseIndex_->verseAt (id);
+      std::string line = fmt::format ("**{}:{}** {}\n", verse.heading, verse.number,
+                                      verse.text.substr (verse.text.find (' ') + 1));
+      if (message.size () + line.size () > maxMessageSize) {
+        break;
       }
-      curl_easy_cleanup (curl);
+      message += line;
     }
+    return message;
+  }
 
-    return "Error: Could not get the Czech exchange rate!";
+  std::string MyDpp::getCzechExchangeRate () {
+    return getCached (DataSource::exchangeRate);
+  }
+
+  std::string MyDpp::formatCzechExchangeRate (const std::string& body) {
+    std::string rawTxtBuffer = body;
+    // replace char "|" with "\t"
+    std::replace (rawTxtBuffer.begin (), rawTxtBuffer.end (), '|', '\t');
+    // LOG_D_STREAM << "Downloaded content:\n" << rawTxtBuffer << std::endl;
+    return rawTxtBuffer;
   }
 
   std::string MyDpp::getSunriset () {
@@ -508,75 +1028,138 @@ namespace dotname {
     LOG_D_STREAM << "XML data:\n" << xmlData << std::endl;
 
     std::string message = "RSS feed:\n";
-    tinyxml2::XMLDocument doc;
-    doc.Parse (xmlData.c_str ());
-
-    tinyxml2::XMLElement* channel = doc.FirstChildElement ("rss")->FirstChildElement ("channel");
-    if (channel == nullptr) {
+    RssStreamParser parser ([&message] (const RssStreamParser::Item& item) {
+      if (item.title.empty () || item.link.empty () || item.description.empty ()) {
+        return;
+      }
+      LOG_I_STREAM << "Title: " << item.title << std::endl;
+      LOG_I_STREAM << "Link: " << item.link << std::endl;
+      LOG_I_STREAM << "Description: " << item.description << std::endl;
+      LOG_I_STREAM << "------------------------" << std::endl;
+
+      message.append ("Title: ").append (item.title).append ("\n");
+      message.append ("Link: ").append (item.link).append ("\n");
+      message.append ("Description: ").append (item.description).append ("\n");
+      message += "------------------------\n";
+    });
+    parser.feed (xmlData);
+    if (!parser.finish ()) {
       LOG_E_STREAM << "Error: RSS feed is not valid." << std::endl;
       return "";
     }
-    tinyxml2::XMLElement* item = channel->FirstChildElement ("item");
-    while (item) {
-      const char* title = item->FirstChildElement ("title")->GetText ();
-      const char* link = item->FirstChildElement ("link")->GetText ();
-      const char* description = item->FirstChildElement ("description")->GetText ();
+    return message;
+  }
 
-      if (title && link && description) {
-        LOG_I_STREAM << "Title: " << title << std::endl;
-        LOG_I_STREAM << "Link: " << link << std::endl;
-        LOG_I_STREAM << "Description: " << description << std::endl;
-        LOG_I_STREAM << "------------------------" << std::endl;
+  std::string MyDpp::getRootcz () {
+    return getCached (DataSource::rootcz);
+  }
 
-        message += "Title: " + std::string (title) + "\n";
-        message += "Link: " + std::string (link) + "\n";
-        message += "Description: " + std::string (description) + "\n";
-        message += "------------------------\n";
+  std::shared_ptr<MyDpp::BodyStream> MyDpp::streamRootcz () {
+    auto items = std::make_shared<std::vector<RSSItem> > ();
+    auto parser = std::make_shared<RssStreamParser> (
+        [items] (const RssStreamParser::Item& item) {
+          if (!item.title.empty () && !item.link.empty ()) {
+            items->push_back (toRSSItem (item));
+          }
+        });
+
+    auto body = std::make_shared<BodyStream> ();
+    body->sink = [parser] (const char* data, std::size_t size) {
+      parser->feed (data, size);
+      return true;
+    };
+    body->finish = [this, parser, items] () -> std::string {
+      if (!parser->finish ()) {
+        LOG_E_STREAM << "Error: RSS feed is not valid." << std::endl;
+        return "";
       }
-      item = item->NextSiblingElement ("item");
-    }
-    return message;
+      const std::size_t added = rootczFeed_->merge (*items);
+      LOG_D_STREAM << "Merged " << added << " of " << items->size () << " RSS items"
+                   << std::endl;
+      return renderRootcz ();
+    };
+    return body;
   }
 
-  std::string MyDpp::getRootcz () {
-    std::string msg = "";
+  std::string MyDpp::renderRootcz () {
     std::string msgFinal = "";
-    CURL* curl;
-    CURLcode res;
-    std::string rawTxtBuffer;
-    curl = curl_easy_init ();
-    if (curl) {
-      curl_easy_setopt (curl, CURLOPT_SSL_VERIFYPEER, 0L); /* temporary - todo cert */
-      curl_easy_setopt (curl, CURLOPT_URL, "https://www.root.cz/rss/clanky/");
-      curl_easy_setopt (curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-      curl_easy_setopt (curl, CURLOPT_WRITEDATA, &rawTxtBuffer);
-
-      res = curl_easy_perform (curl);
-
-      if (res != CURLE_OK) {
-        LOG_E_STREAM << "curl_easy_perform() failed: " << curl_easy_strerror (res) << std::endl;
-      } else {
-        // LOG_D_STREAM << "Downloaded content:\n" << rawTxtBuffer << std::endl;
-        parseRSSToStruct (rawTxtBuffer);
-        for (const auto& item : feedRootCz.getItems ()) {
-          LOG_I_STREAM << "Title: " << item.title << std::endl;
-          LOG_I_STREAM << "Link: " << item.link << std::endl;
-          msg = "[" + item.title + "](" + item.link + ")\n";
-          if (msg.size () + msgFinal.size () < 2000) {
-            msgFinal += msg;
-          }
-        }
-        int len = msgFinal.length ();
-        return msgFinal;
+    // newest first, only as many items as fit into one message are visited
+    rootczFeed_->forEachNewest (
+        [&msgFinal] (const RSSItem& item) { return appendLink (msgFinal, item); });
+    return msgFinal;
+  }
+
+  MyDpp::ResponseLoader MyDpp::loadWhenFetched (const DataSource& source) {
+    return [this, &source] (std::function<void (bool, std::string)> complete) {
+      std::shared_ptr<BodyStream> body = source.open (*this);
+      asyncHttpClient_->fetch (
+          source.url, source.validators (*this), body ? body->sink : nullptr,
+          [this, &source, body, complete] (HttpClient::Response&& response) {
+            std::string message;
+            const bool ok = source.read (*this, response, body.get (), message);
+            complete (ok, std::move (message));
+          });
+    };
+  }
+
+  std::string MyDpp::getCached (const DataSource& source) {
+    std::string message;
+    if (responseCache_->lookup (source.url, source.policy, loadWhenFetched (source), message)) {
+      return message;
+    }
+
+    // a miss is loaded on the calling thread, concurrent callers wait for the same load
+    auto load = [this, &source] (std::function<void (bool, std::string)> complete) {
+      std::shared_ptr<BodyStream> body = source.open (*this);
+      HttpClient::Response response = httpClient_->get (source.url, source.validators (*this),
+                                                        body ? body->sink : nullptr);
+      std::string loaded;
+      const bool ok = source.read (*this, response, body.get (), loaded);
+      complete (ok, std::move (loaded));
+    };
+    auto promise = std::make_shared<std::promise<std::string> > ();
+    std::future<std::string> future = promise->get_future ();
+    responseCache_->fetch (source.url, source.policy, load,
+                           [promise, &source] (const std::string* cached) {
+                             promise->set_value (cached ? *cached : source.error);
+                           });
+    return future.get ();
+  }
+
+  void MyDpp::replyWhenFetched (const dpp::slashcommand_t& event, const DataSource& source) {
+    std::string message;
+    if (responseCache_->lookup (source.url, source.policy, loadWhenFetched (source), message)) {
+      event.reply (message);
+      return;
+    }
+
+    // acknowledge within Discord's 3 s deadline, the answer follows once upstream responds
+    event.thinking (false, [this, event, &source] (const dpp::confirmation_callback_t& ack) {
+      if (ack.is_error ()) {
+        LOG_E_STREAM << "Error: Could not defer reply to /" << event.command.get_command_name ()
+                     << std::endl;
+        return;
       }
-      curl_easy_cleanup (curl);
+      responseCache_->fetch (source.url, source.policy, loadWhenFetched (source),
+                             [event, &source] (const std::string* cached) {
+                               event.edit_response (cached ? *cached : source.error);
+                             });
+    });
+  }
+
+  void MyDpp::recordLatency (const Command& command,
+                             std::chrono::steady_clock::time_point received) {
+    const auto latency = std::chrono::steady_clock::now () - received;
+    commandLatency_->record (command.name, latency);
+    if (command.handler && latency > std::chrono::milliseconds (INTERACTION_DEADLINE_MS)) {
+      LOG_W_KV ("Warning: Command missed the interaction deadline", { "command", command.name },
+                { "ms", std::chrono::duration_cast<std::chrono::milliseconds> (latency).count () });
     }
-    return "Error: Could not get the Bitcoin price!";
   }
 
   bool MyDpp::loadVariousBotCommands () {
 
-    m_bot->on_log ([&] (const dpp::log_t& log) {
+    m_bot->on_log ([] (const dpp::log_t& log) {
       // std::cout << "[" << dpp::utility::current_date_time() << "] "
       //           << dpp::utility::loglevel(log.severity) << ": " <<
       //           log.message
@@ -586,154 +1169,79 @@ namespace dotname {
                    << dpp::utility::loglevel (log.severity) << ": " << log.message << std::endl;
     });
 
-    m_bot->on_slashcommand ([&, this] (const dpp::slashcommand_t& event) {
-      if (event.command.get_command_name () == "verse") {
-        std::string message = getCzechBibleVerse ();
-        dpp::message msg (channelDev, message);
-        event.reply (msg);
+    m_bot->on_slashcommand ([this] (const dpp::slashcommand_t& event) {
+      const std::string name = event.command.get_command_name ();
+      const Command* command = Command::find (name);
+      if (!command) {
+        LOG_W_STREAM << "Warning: Unknown command /" << name << std::endl;
+        event.reply ("Unknown command! 🛑");
+        return;
       }
-
-      if (event.command.get_command_name () == "sunriset") {
-        std::string message = getSunriset ();
-        dpp::message msg (channelDev, message);
-        event.reply (msg);
-      }
-
-      if (event.command.get_command_name () == "czk") {
-        std::string message = getCzechExchangeRate ();
-        dpp::message msg (channelDev, message);
-        event.reply (msg);
+      const auto received = std::chrono::steady_clock::now ();
+      if (command->handler) {
+        command->handler (*this, event);
+        recordLatency (*command, received);
+        return;
       }
 
-      if (event.command.get_command_name () == "btc") {
-        std::string message = getBitcoinPrice ();
-        dpp::message msg (channelDev, message);
-        event.reply (msg);
-      }
-
-      if (event.command.get_command_name () == "fortune") {
-        std::string message = getLinuxFortuneCpp ();
-        dpp::message msg (channelDev, "Quote\n\t" + message);
-        event.reply (msg);
-      }
-
-      if (event.command.get_command_name () == "noemojies") {
-        if (!isRefreshEmojiesRunning.load ()) {
-          dpp::message msg (channelDev, "Emojies are already stopped! 🛑");
-          event.reply (msg);
+      // acknowledged at once, the answer follows from the command pool
+      event.thinking (false, [this, command, event,
+                              received] (const dpp::confirmation_callback_t& ack) {
+        if (ack.is_error ()) {
+          LOG_E_STREAM << "Error: Could not defer reply to /" << command->name << std::endl;
           return;
         }
-        event.reply ("Emojies are stopped! 🛑");
-        isRefreshEmojiesRunning.store (false);
-        stopRefreshEmojies.store (true);
-      }
-
-      if (event.command.get_command_name () == "emojies") {
-
-        if (isRefreshEmojiesRunning.load ()) {
-          dpp::message msg (channelDev, "Emojies already running! 🕒");
-          event.reply (msg);
-          return;
+        const bool posted = commandPool_->post ([this, command, event, received] () {
+          std::string message;
+          try {
+            message = command->answer (*this, event);
+          } catch (const std::exception& e) {
+            LOG_E_STREAM << "Error: /" << command->name << " failed: " << e.what () << std::endl;
+            message = "Error: Could not answer /" + std::string (command->name) + "!";
+          }
+          event.edit_response (message);
+          recordLatency (*command, received);
+        });
+        if (!posted) {
+          event.edit_response ("Bot is stopping! 🛑");
         }
+      });
+    });
 
-        event.reply ("Emojies are being sent in regularly interval 10 seconds! 🕒");
-        stopRefreshEmojies.store (false);
-        startPollingEmojies ();
-      }
-
-      if (event.command.get_command_name () == "emoji") {
-        std::string buf = emojiTools->getRandomEmoji ();
-        LOG_I_STREAM << buf << std::endl;
-        event.reply (buf);
+    m_bot->on_ready ([this] (const dpp::ready_t& event) {
+      if (!dpp::run_once<struct RegisterCommands> ()) {
+        return;
       }
-
-      if (event.command.get_command_name () == "rss") {
-        std::string buf = getRootcz ();
-        if (buf.empty ()) {
-          dpp::message msg (channelDev, "Error: Could not get the RSS feed!");
-          event.reply (msg);
-          return;
+      std::vector<dpp::slashcommand> commands;
+      for (const Command& command : Command::table) {
+        dpp::slashcommand slashcommand (command.name, command.description, m_bot->me.id);
+        if (command.options) {
+          command.options (slashcommand);
         }
-        LOG_I_STREAM << buf << std::endl;
-        event.reply (buf);
-      }
-
-      if (event.command.get_command_name () == "ping") {
-        event.reply ("Pong! 🏓");
-      }
-
-      if (event.command.get_command_name () == "pong") {
-        event.reply ("Ping! 🏓");
-      }
-
-      if (event.command.get_command_name () == "gang") {
-        dpp::message msg (event.command.channel_id, "Bang bang! 💥💥");
-        event.reply (msg);
-        m_bot->message_create (msg);
+        commands.push_back (slashcommand);
       }
 
-      if (event.command.get_command_name () == "bot") {
-        dpp::message msgFastfetch (channelDev,
-                                   this->getLinuxFastfetchCpp ().substr (0, 8192 - 2) + "\n");
-        event.reply (msgFastfetch);
+      // a reconnect or a redeploy with the same commands makes no call at all
+      const dpp::snowflake application = m_bot->me.id;
+      const std::uint64_t hash = commandsHash (commands);
+      const std::filesystem::path stored = statePath (COMMANDS_HASH_FILE);
+      if (isRegistered (stored, application, hash)) {
+        LOG_D_STREAM << "Slash commands are registered already" << std::endl;
+        return;
       }
-
-      if (event.command.get_command_name () == "stopbot") {
-        dpp::message msgFastfetch (channelDev, "stoping bot ...\n");
-        event.reply (msgFastfetch);
-        // stop D++
-        m_bot->shutdown ();
-      }
-    });
-
-    m_bot->on_ready ([&] (const dpp::ready_t& event) {
-      /* sunriset */
-      m_bot->global_command_create (dpp::slashcommand ("sunriset", "Get sunriset!", m_bot->me.id));
-
-      /* snippet */
-      m_bot->global_command_create (
-          dpp::slashcommand ("verse", "Get verse from Czech Bible!", m_bot->me.id));
-
-      /* czk */
-      m_bot->global_command_create (dpp::slashcommand ("czk", "Get Czech Exchange!", m_bot->me.id));
-
-      /* bitcoin */
-      m_bot->global_command_create (dpp::slashcommand ("btc", "Get Bitcoin Price!", m_bot->me.id));
-
-      /* fortune */
-      m_bot->global_command_create (
-          dpp::slashcommand ("fortune", "Get random Quote!", m_bot->me.id));
-
-      /* noemojies */
-      m_bot->global_command_create (dpp::slashcommand (
-          "noemojies", "Stop to getting random Emoji in regularly interval 10 seconds!",
-          m_bot->me.id));
-
-      /* emojies */
-      m_bot->global_command_create (dpp::slashcommand (
-          "emojies", "Get random Emoji in regularly interval 10 seconds!", m_bot->me.id));
-
-      /* emoji */
-      m_bot->global_command_create (dpp::slashcommand ("emoji", "Get random Emoji!", m_bot->me.id));
-
-      /* rss */
-      m_bot->global_command_create (dpp::slashcommand ("rss", "Get rss feed!", m_bot->me.id));
-
-      /* ping */
-      m_bot->global_command_create (dpp::slashcommand ("ping", "Ping pong!", m_bot->me.id));
-
-      /* pong */
-      m_bot->global_command_create (dpp::slashcommand ("pong", "Pong ping!", m_bot->me.id));
-
-      /* gang */
-      m_bot->global_command_create (dpp::slashcommand ("gang", "Will shoot!", m_bot->me.id));
-
-      /* bot */
-      m_bot->global_command_create (
-          dpp::slashcommand ("stopbot", "Stop DSDotBot Bot!", m_bot->me.id));
-
-      /* bot */
-      m_bot->global_command_create (dpp::slashcommand ("bot", "About DSDotBot Bot!", m_bot->me.id));
+      // one call replaces the whole set, commands missing from the table are deleted
+      m_bot->global_bulk_command_create (
+          commands, [stored, application, hash] (const dpp::confirmation_callback_t& callback) {
+            if (callback.is_error ()) {
+              LOG_E_STREAM << "Error: Could not register slash commands" << std::endl;
+              return;
+            }
+            LOG_I_STREAM << "Slash commands registered" << std::endl;
+            std::ofstream file (stored, std::ios::trunc);
+            if (!(file << application << " " << hash << std::endl)) {
+              LOG_W_STREAM << "Warning: Could not write " << stored << std::endl;
+            }
+          });
     });
 
     return true;
@@ -758,64 +1266,28 @@ namespace dotname {
 
   MyDpp::RSSFeed MyDpp::parseRSSToStruct (const std::string& xmlData) {
     LOG_D_STREAM << "Parsing RSS feed to structure..." << std::endl;
+    RSSFeed feed;
 
-    tinyxml2::XMLDocument doc;
-    doc.Parse (xmlData.c_str ());
-
-    tinyxml2::XMLElement* rssElement = doc.FirstChildElement ("rss");
-    if (!rssElement) {
-      LOG_E_STREAM << "Error: No RSS root element found." << std::endl;
-      return feedRootCz;
-    }
-
-    tinyxml2::XMLElement* channel = rssElement->FirstChildElement ("channel");
-    if (!channel) {
+    RssStreamParser parser ([&feed] (const RssStreamParser::Item& item) {
+      if (!item.title.empty () && !item.link.empty ()) {
+        feed.addItem (toRSSItem (item));
+        LOG_D_STREAM << "Parsed item: " << item.title << std::endl;
+      }
+    });
+    parser.feed (xmlData);
+    if (!parser.finish ()) {
       LOG_E_STREAM << "Error: RSS feed is not valid." << std::endl;
-      return feedRootCz;
+      return feed;
     }
 
     // Parse channel info
-    if (auto titleElement = channel->FirstChildElement ("title")) {
-      feedRootCz.title = titleElement->GetText () ? titleElement->GetText () : "";
-    }
-    if (auto descElement = channel->FirstChildElement ("description")) {
-      feedRootCz.description = descElement->GetText () ? descElement->GetText () : "";
-    }
-    if (auto linkElement = channel->FirstChildElement ("link")) {
-      feedRootCz.link = linkElement->GetText () ? linkElement->GetText () : "";
-    }
-
-    // Parse items
-    tinyxml2::XMLElement* item = channel->FirstChildElement ("item");
-    while (item) {
-      RSSItem rssItem;
-
-      if (auto titleElement = item->FirstChildElement ("title")) {
-        rssItem.title = titleElement->GetText () ? titleElement->GetText () : "";
-      }
-      if (auto linkElement = item->FirstChildElement ("link")) {
-        rssItem.link = linkElement->GetText () ? linkElement->GetText () : "";
-      }
-      if (auto descElement = item->FirstChildElement ("description")) {
-        rssItem.description = descElement->GetText () ? descElement->GetText () : "";
-      }
-      if (auto pubDateElement = item->FirstChildElement ("pubDate")) {
-        rssItem.pubDate = pubDateElement->GetText () ? pubDateElement->GetText () : "";
-      }
-      if (auto guidElement = item->FirstChildElement ("guid")) {
-        rssItem.guid = guidElement->GetText () ? guidElement->GetText () : "";
-      }
-
-      if (!rssItem.title.empty () && !rssItem.link.empty ()) {
-        feedRootCz.addItem (rssItem);
-        LOG_I_STREAM << "Added item: " << rssItem.title << std::endl;
-      }
-
-      item = item->NextSiblingElement ("item");
-    }
+    const RssStreamParser::Item channel = parser.channel ();
+    feed.title = std::string (channel.title);
+    feed.description = std::string (channel.description);
+    feed.link = std::string (channel.link);
 
-    LOG_I_STREAM << "Parsed " << feedRootCz.getItemCount () << " RSS items" << std::endl;
-    return feedRootCz;
+    LOG_I_STREAM << "Parsed " << feed.getItemCount () << " RSS items" << std::endl;
+    return feed;
   }
 
   // Helper method to convert RSSFeed back to string if needed
@@ -0,0 +1,265 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include "FeedAggregator.hpp"
+#include "RssStreamParser.hpp"
+
+#include <Http/AsyncHttpClient.hpp>
+#include <Logger/Logger.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+namespace dotname {
+
+  struct FeedAggregator::Round {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<Feed> > feeds;
+    std::size_t next = 0;
+    std::size_t pending = 0;
+    std::vector<Post> posts;
+    Done done;
+  };
+
+  FeedAggregator::FeedAggregator (AsyncHttpClient& http, std::size_t maxInFlight,
+                                  std::size_t itemsPerFeed)
+      : http_ (http), maxInFlight_ (maxInFlight ? maxInFlight : 1),
+        itemsPerFeed_ (itemsPerFeed) {
+  }
+
+  bool FeedAggregator::load (const std::filesystem::path& path) {
+    std::ifstream file (path);
+    if (!file.is_open ()) {
+      LOG_E_STREAM << "Error: Could not open file " << path << std::endl;
+      return false;
+    }
+
+    std::string line;
+    std::size_t number = 0;
+    while (std::getline (file, line)) {
+      ++number;
+      line = line.substr (0, line.find ('#'));
+      std::istringstream fields (line);
+      std::string channel;
+      std::string url;
+      if (!(fields >> channel)) {
+        continue;
+      }
+      Channel id = 0;
+      try {
+        id = std::stoull (channel);
+      } catch (const std::exception&) {
+        id = 0;
+      }
+      if (id == 0 || !(fields >> url)) {
+        LOG_W_STREAM << "Warning: " << path << ":" << number << " is not <channel id> <url>"
+                     << std::endl;
+        continue;
+      }
+      subscribe (id, url);
+    }
+    return true;
+  }
+
+  void FeedAggregator::subscribe (Channel channel, const std::string& url) {
+    std::lock_guard<std::mutex> lock (mutex_);
+    std::shared_ptr<Feed>& feed = feeds_[url];
+    if (!feed) {
+      feed = std::make_shared<Feed> (url, itemsPerFeed_);
+    }
+    if (std::find (feed->channels.begin (), feed->channels.end (), channel)
+        == feed->channels.end ()) {
+      feed->channels.push_back (channel);
+    }
+  }
+
+  bool FeedAggregator::unsubscribe (Channel channel, const std::string& url) {
+    std::lock_guard<std::mutex> lock (mutex_);
+    auto it = feeds_.find (url);
+    if (it == feeds_.end ()) {
+      return false;
+    }
+    std::vector<Channel>& channels = it->second->channels;
+    auto at = std::find (channels.begin (), channels.end (), channel);
+    if (at == channels.end ()) {
+      return false;
+    }
+    channels.erase (at);
+    if (channels.empty ()) {
+      feeds_.erase (it);
+    }
+    return true;
+  }
+
+  std::vector<std::string> FeedAggregator::feedsOf (Channel channel) const {
+    std::vector<std::string> urls;
+    std::lock_guard<std::mutex> lock (mutex_);
+    for (const auto& [url, feed] : feeds_) {
+      if (std::find (feed->channels.begin (), feed->channels.end (), channel)
+          != feed->channels.end ()) {
+        urls.push_back (url);
+      }
+    }
+    std::sort (urls.begin (), urls.end ());
+    return urls;
+  }
+
+  std::size_t FeedAggregator::feedCount () const {
+    std::lock_guard<std::mutex> lock (mutex_);
+    return feeds_.size ();
+  }
+
+  bool FeedAggregator::refresh (Done done) {
+    auto round = std::make_shared<Round> ();
+    round->done = std::move (done);
+    {
+      std::lock_guard<std::mutex> lock (mutex_);
+      if (refreshing_) {
+        return false;
+      }
+      refreshing_ = !feeds_.empty ();
+      for (const auto& entry : feeds_) {
+        round->feeds.push_back (entry.second);
+      }
+    }
+    if (round->feeds.empty ()) {
+      round->done ({});
+      return true;
+    }
+
+    round->pending = round->feeds.size ();
+    const std::size_t start = std::min (maxInFlight_, round->feeds.size ());
+    for (std::size_t i = 0; i < start; ++i) {
+      fetch (round);
+    }
+    return true;
+  }
+
+  void FeedAggregator::fetch (const std::shared_ptr<Round>& round) {
+    std::shared_ptr<Feed> feed;
+    {
+      std::lock_guard<std::mutex> lock (round->mutex);
+      if (round->next == round->feeds.size ()) {
+        return;
+      }
+      feed = round->feeds[round->next++];
+    }
+    HttpClient::Validators validators;
+    {
+      std::lock_guard<std::mutex> lock (mutex_);
+      validators = feed->validators;
+    }
+
+    auto items = std::make_shared<std::vector<FeedItem> > ();
+    auto parser = std::make_shared<RssStreamParser> (
+        [items] (const RssStreamParser::Item& item) {
+          if (!item.title.empty () && !item.link.empty ()) {
+            items->push_back (FeedItem{ std::string (item.title), std::string (item.link),
+                                        std::string (item.description),
+                                        std::string (item.pubDate), std::string (item.guid) });
+          }
+        });
+    http_.fetch (
+        feed->url, validators,
+        [parser] (const char* data, std::size_t size) {
+          parser->feed (data, size);
+          return true;
+        },
+        [this, round, feed, parser, items] (HttpClient::Response&& response) {
+          finished (round, *feed, response, parser->finish (), *items);
+          // the finished transfer's slot goes to the next feed
+          fetch (round);
+        });
+  }
+
+  void FeedAggregator::finished (const std::shared_ptr<Round>& round, Feed& feed,
+                                 const HttpClient::Response& response, bool parsed,
+                                 const std::vector<FeedItem>& items) {
+    std::vector<FeedItem> added;
+    std::vector<Channel> channels;
+    if (response.ok () && parsed) {
+      feed.items.merge (items, &added);
+      std::lock_guard<std::mutex> lock (mutex_);
+      feed.validators = HttpClient::Validators{ response.etag, response.lastModified };
+      if (feed.primed) {
+        channels = feed.channels;
+      }
+      feed.primed = true;
+    } else if (response.ok ()) {
+      LOG_W_STREAM << "Warning: " << feed.url << " is not an RSS or Atom feed" << std::endl;
+    }
+
+    Done done;
+    std::vector<Post> posts;
+    {
+      std::lock_guard<std::mutex> lock (round->mutex);
+      for (const FeedItem& item : added) {
+        for (Channel channel : channels) {
+          round->posts.push_back (Post{ channel, item });
+        }
+      }
+      if (--round->pending != 0) {
+        return;
+      }
+      posts.swap (round->posts);
+      done = std::move (round->done);
+    }
+
+    // each date parsed once, not on every comparison
+    std::vector<std::pair<std::int64_t, Post> > dated;
+    dated.reserve (posts.size ());
+    for (Post& post : posts) {
+      const std::int64_t published = parsePubDate (post.item.pubDate);
+      dated.emplace_back (published, std::move (post));
+    }
+    std::stable_sort (dated.begin (), dated.end (),
+                      [] (const auto& a, const auto& b) { return a.first < b.first; });
+    for (std::size_t i = 0; i < dated.size (); ++i) {
+      posts[i] = std::move (dated[i].second);
+    }
+    {
+      std::lock_guard<std::mutex> lock (mutex_);
+      refreshing_ = false;
+    }
+    if (done) {
+      done (std::move (posts));
+    }
+  }
+
+  std::vector<FeedItem> FeedAggregator::timeline (Channel channel, std::size_t limit) const {
+    std::vector<std::shared_ptr<Feed> > subscribed;
+    {
+      std::lock_guard<std::mutex> lock (mutex_);
+      for (const auto& entry : feeds_) {
+        const std::vector<Channel>& channels = entry.second->channels;
+        if (std::find (channels.begin (), channels.end (), channel) != channels.end ()) {
+          subscribed.push_back (entry.second);
+        }
+      }
+    }
+    if (limit == 0) {
+      return {};
+    }
+
+    // the newest limit items of each feed are enough to merge the newest limit overall
+    std::vector<std::pair<std::int64_t, FeedItem> > merged;
+    for (const std::shared_ptr<Feed>& feed : subscribed) {
+      std::size_t taken = 0;
+      feed->items.forEachNewest ([&] (const FeedItem& item) {
+        merged.emplace_back (parsePubDate (item.pubDate), item);
+        return ++taken < limit;
+      });
+    }
+    std::stable_sort (merged.begin (), merged.end (),
+                      [] (const auto& a, const auto& b) { return a.first > b.first; });
+
+    std::vector<FeedItem> items;
+    for (std::size_t i = 0; i < merged.size () && i < limit; ++i) {
+      items.push_back (std::move (merged[i].second));
+    }
+    return items;
+  }
+
+} // namespace dotname
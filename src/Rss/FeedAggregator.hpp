@@ -0,0 +1,100 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#ifndef FEEDAGGREGATOR_HPP
+#define FEEDAGGREGATOR_HPP
+
+#include "FeedStore.hpp"
+
+#include <Http/HttpClient.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace dotname {
+
+  class AsyncHttpClient;
+
+  struct FeedItem {
+    std::string title;
+    std::string link;
+    std::string description;
+    std::string pubDate;
+    std::string guid;
+  };
+
+  // RSS / Atom feeds subscribed by Discord channels, refreshed together.
+  //
+  // Every feed is fetched once per refresh however many channels subscribe
+  // it, conditionally and streamed through RssStreamParser. Fetches run on the
+  // AsyncHttpClient driver with at most maxInFlight transfers at a time, so
+  // hundreds of feeds cost no extra threads. Each feed keeps its newest items
+  // in a FeedStore, a channel's timeline merges the feeds it subscribes.
+  // Thread safe; the AsyncHttpClient has to be destroyed first.
+  class FeedAggregator {
+  public:
+    using Channel = std::uint64_t;
+
+    struct Post {
+      Channel channel;
+      FeedItem item;
+    };
+    using Done = std::function<void (std::vector<Post>&& posts)>;
+
+    explicit FeedAggregator (AsyncHttpClient& http, std::size_t maxInFlight = 16,
+                             std::size_t itemsPerFeed = 64);
+    FeedAggregator (const FeedAggregator&) = delete;
+    FeedAggregator& operator= (const FeedAggregator&) = delete;
+
+    // Subscriptions from lines "<channel id> <feed url>", '#' starts a comment
+    bool load (const std::filesystem::path& path);
+    void subscribe (Channel channel, const std::string& url);
+    bool unsubscribe (Channel channel, const std::string& url);
+    std::vector<std::string> feedsOf (Channel channel) const;
+    std::size_t feedCount () const;
+
+    // Fetches every feed, done gets the items not seen before, oldest first, once all
+    // feeds answered. The first refresh of a feed only learns what it already lists.
+    // False when the previous refresh is still running.
+    bool refresh (Done done);
+
+    // Newest items of the channel's feeds merged by publication date
+    std::vector<FeedItem> timeline (Channel channel, std::size_t limit) const;
+
+  private:
+    struct Feed {
+      std::string url;
+      FeedStore<FeedItem> items;
+      std::vector<Channel> channels;
+      HttpClient::Validators validators;
+      bool primed = false;
+
+      Feed (const std::string& address, std::size_t capacity) : url (address), items (capacity) {
+      }
+    };
+    struct Round;
+
+    void fetch (const std::shared_ptr<Round>& round);
+    void finished (const std::shared_ptr<Round>& round, Feed& feed,
+                   const HttpClient::Response& response, bool parsed,
+                   const std::vector<FeedItem>& items);
+
+    AsyncHttpClient& http_;
+    const std::size_t maxInFlight_;
+    const std::size_t itemsPerFeed_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<Feed> > feeds_;
+    bool refreshing_ = false;
+  };
+
+} // namespace dotname
+
+#endif // FEEDAGGREGATOR_HPP
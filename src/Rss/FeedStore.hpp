@@ -0,0 +1,257 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#ifndef FEEDSTORE_HPP
+#define FEEDSTORE_HPP
+
+#include <cctype>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace dotname {
+
+  // Seconds since the epoch, month is 1-12 and offset in minutes east of UTC
+  inline std::int64_t epochSeconds (int year, int month, int day, int hour, int minute,
+                                    int second, int offset) {
+    // days from civil, proleptic Gregorian calendar
+    const int y = month <= 2 ? year - 1 : year;
+    const int era = (y >= 0 ? y : y - 399) / 400;
+    const int yoe = y - era * 400;
+    const int doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    const std::int64_t days = static_cast<std::int64_t> (era) * 146097 + doe - 719468;
+    return days * 86400 + hour * 3600 + minute * 60 + second - offset * 60;
+  }
+
+  // Seconds since the epoch of an RFC 822 date ("Sat, 07 Sep 2002 09:42:31 +0200") or
+  // of an Atom one ("2002-09-07T09:42:31Z"), 0 when the date cannot be read
+  inline std::int64_t parsePubDate (const std::string& date) {
+    const char* p = date.c_str ();
+    auto skipSpaces = [&p] () {
+      while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r') {
+        ++p;
+      }
+    };
+    auto number = [&p] (int maxDigits, int& value) {
+      int digits = 0;
+      value = 0;
+      while (digits < maxDigits && std::isdigit (static_cast<unsigned char> (*p))) {
+        value = value * 10 + (*p++ - '0');
+        ++digits;
+      }
+      return digits > 0;
+    };
+
+    skipSpaces ();
+    int year = 0;
+    int month = 0;
+    int day = 0;
+    int hour = 0;
+    int minute = 0;
+    int second = 0;
+    int offset = 0; // minutes east of UTC, named zones other than UTC count as UTC
+    auto zone = [&p, &number, &offset] () {
+      if (*p == '+' || *p == '-') {
+        const int sign = *p++ == '-' ? -1 : 1;
+        int hours = 0;
+        int minutes = 0;
+        if (number (2, hours)) {
+          if (*p == ':') {
+            ++p;
+          }
+          number (2, minutes);
+          offset = sign * (hours * 60 + minutes);
+        }
+      }
+    };
+
+    // RFC 3339 as used by Atom
+    if (std::strlen (p) >= 10 && p[4] == '-') {
+      if (!number (4, year) || *p++ != '-' || !number (2, month) || *p++ != '-'
+          || !number (2, day) || (*p != 'T' && *p != 't' && *p != ' ')) {
+        return 0;
+      }
+      ++p;
+      if (!number (2, hour) || *p++ != ':' || !number (2, minute) || *p++ != ':'
+          || !number (2, second)) {
+        return 0;
+      }
+      while (*p == '.' || std::isdigit (static_cast<unsigned char> (*p))) {
+        ++p;
+      }
+      zone ();
+      return epochSeconds (year, month, day, hour, minute, second, offset);
+    }
+
+    if (std::isalpha (static_cast<unsigned char> (*p))) {
+      const char* comma = std::strchr (p, ',');
+      if (!comma) {
+        return 0;
+      }
+      p = comma + 1;
+      skipSpaces ();
+    }
+
+    if (!number (2, day)) {
+      return 0;
+    }
+    skipSpaces ();
+    static const char months[] = "JanFebMarAprMayJunJulAugSepOctNovDec";
+    while (month < 12 && std::strncmp (p, months + month * 3, 3) != 0) {
+      ++month;
+    }
+    if (month == 12) {
+      return 0;
+    }
+    p += 3;
+    skipSpaces ();
+    if (!number (4, year)) {
+      return 0;
+    }
+    if (year < 100) {
+      year += year < 50 ? 2000 : 1900; // two digit years of RFC 822
+    }
+    skipSpaces ();
+    if (!number (2, hour) || *p++ != ':' || !number (2, minute)) {
+      return 0;
+    }
+    if (*p == ':') {
+      ++p;
+      if (!number (2, second)) {
+        return 0;
+      }
+    }
+    skipSpaces ();
+    zone ();
+    return epochSeconds (year, month + 1, day, hour, minute, second, offset);
+  }
+
+  // Bounded, de-duplicated store of feed items ordered by publication date.
+  //
+  // Items live in a fixed ring buffer sorted from the oldest to the newest,
+  // a hash set of their guids (links when a feed has none) rejects items that
+  // were merged before. A full store evicts its oldest item and remembers its
+  // guid for another 4 x capacity evictions, so a feed listing more items than
+  // fit is not merged again on every poll, and memory stays fixed however often
+  // the feed is polled. Items without a readable date count as published when
+  // they were merged. Item needs guid, link and pubDate string members. Thread
+  // safe.
+  template <typename Item> class FeedStore {
+  public:
+    explicit FeedStore (std::size_t capacity) : slots_ (capacity ? capacity : 1) {
+    }
+    FeedStore (const FeedStore&) = delete;
+    FeedStore& operator= (const FeedStore&) = delete;
+
+    // Merges the items not stored yet, returns how many were added and appends them to added
+    std::size_t merge (const std::vector<Item>& items, std::vector<Item>* added = nullptr) {
+      std::lock_guard<std::mutex> lock (mutex_);
+      const std::int64_t now = std::chrono::duration_cast<std::chrono::seconds> (
+                                   std::chrono::system_clock::now ().time_since_epoch ())
+                                   .count ();
+      std::size_t count = 0;
+      for (const Item& item : items) {
+        const std::string& key = keyOf (item);
+        if (key.empty () || keys_.count (key) != 0) {
+          continue;
+        }
+        if (insert (item, now)) {
+          keys_.insert (key);
+          ++count;
+          if (added) {
+            added->push_back (item);
+          }
+        }
+      }
+      return count;
+    }
+
+    // Calls visit (item) from the newest item on until it returns false
+    template <typename Visit> void forEachNewest (Visit visit) const {
+      std::lock_guard<std::mutex> lock (mutex_);
+      for (std::size_t i = size_; i-- > 0;) {
+        if (!visit (slots_[slot (i)].item)) {
+          return;
+        }
+      }
+    }
+
+    std::size_t size () const {
+      std::lock_guard<std::mutex> lock (mutex_);
+      return size_;
+    }
+    std::size_t capacity () const {
+      return slots_.size ();
+    }
+
+  private:
+    struct Slot {
+      Item item{};
+      std::int64_t published = 0;
+    };
+
+    static const std::string& keyOf (const Item& item) {
+      return item.guid.empty () ? item.link : item.guid;
+    }
+
+    // physical slot of the i-th oldest item
+    std::size_t slot (std::size_t i) const {
+      return (head_ + i) % slots_.size ();
+    }
+
+    bool insert (const Item& item, std::int64_t now) {
+      std::int64_t published = parsePubDate (item.pubDate);
+      if (published == 0) {
+        published = now;
+      }
+      // feeds list the newest items first, scan from the newest end
+      std::size_t at = size_;
+      while (at > 0 && slots_[slot (at - 1)].published > published) {
+        --at;
+      }
+
+      if (size_ == slots_.size ()) {
+        if (at == 0) {
+          return false; // older than everything kept
+        }
+        retire (keyOf (slots_[head_].item));
+        head_ = slot (1);
+        --size_;
+        --at;
+      }
+
+      for (std::size_t i = size_; i > at; --i) {
+        slots_[slot (i)] = std::move (slots_[slot (i - 1)]);
+      }
+      slots_[slot (at)] = Slot{ item, published };
+      ++size_;
+      return true;
+    }
+
+    // the key of an evicted item still rejects it until it is the oldest of the retired ones
+    void retire (const std::string& key) {
+      retired_.push_back (key);
+      if (retired_.size () > slots_.size () * 4) {
+        keys_.erase (retired_.front ());
+        retired_.pop_front ();
+      }
+    }
+
+    mutable std::mutex mutex_;
+    std::vector<Slot> slots_;
+    std::size_t head_ = 0;
+    std::size_t size_ = 0;
+    std::unordered_set<std::string> keys_;
+    std::deque<std::string> retired_;
+  };
+
+} // namespace dotname
+
+#endif // FEEDSTORE_HPP
@@ -0,0 +1,415 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include "RssStreamParser.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+namespace dotname {
+
+  namespace {
+    constexpr std::string_view cdataOpen = "<![CDATA[";
+    constexpr std::string_view commentOpen = "<!--";
+    // longest entity kept, "&#x10FFFF;" and the named ones are shorter
+    constexpr std::size_t maxEntity = 12;
+
+    bool isSpace (char c) {
+      return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    void appendUtf8 (std::string& out, std::uint32_t cp) {
+      if (cp < 0x80) {
+        out += static_cast<char> (cp);
+      } else if (cp < 0x800) {
+        out += static_cast<char> (0xC0 | (cp >> 6));
+        out += static_cast<char> (0x80 | (cp & 0x3F));
+      } else if (cp < 0x10000) {
+        out += static_cast<char> (0xE0 | (cp >> 12));
+        out += static_cast<char> (0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char> (0x80 | (cp & 0x3F));
+      } else {
+        out += static_cast<char> (0xF0 | (cp >> 18));
+        out += static_cast<char> (0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char> (0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char> (0x80 | (cp & 0x3F));
+      }
+    }
+
+    // name is the entity without '&' and ';'
+    bool decodeEntity (std::string_view name, std::string& out) {
+      if (name.size () > 1 && name[0] == '#') {
+        const bool hex = name[1] == 'x' || name[1] == 'X';
+        std::uint32_t cp = 0;
+        std::size_t i = hex ? 2 : 1;
+        if (i == name.size ()) {
+          return false;
+        }
+        for (; i < name.size (); ++i) {
+          const char c = name[i];
+          std::uint32_t digit = 0;
+          if (c >= '0' && c <= '9') {
+            digit = static_cast<std::uint32_t> (c - '0');
+          } else if (hex && c >= 'a' && c <= 'f') {
+            digit = static_cast<std::uint32_t> (c - 'a' + 10);
+          } else if (hex && c >= 'A' && c <= 'F') {
+            digit = static_cast<std::uint32_t> (c - 'A' + 10);
+          } else {
+            return false;
+          }
+          cp = cp * (hex ? 16 : 10) + digit;
+          if (cp > 0x10FFFF) {
+            return false;
+          }
+        }
+        appendUtf8 (out, cp);
+        return true;
+      }
+
+      static constexpr std::pair<std::string_view, char> named[] = {
+        { "amp", '&' }, { "lt", '<' }, { "gt", '>' }, { "quot", '"' }, { "apos", '\'' }
+      };
+      for (const auto& [entity, c] : named) {
+        if (name == entity) {
+          out += c;
+          return true;
+        }
+      }
+      return false;
+    }
+
+    void appendDecoded (std::string& out, std::string_view raw) {
+      while (!raw.empty ()) {
+        const std::size_t amp = raw.find ('&');
+        out.append (raw.data (), std::min (amp, raw.size ()));
+        if (amp == std::string_view::npos) {
+          return;
+        }
+        raw.remove_prefix (amp);
+        const std::size_t semicolon = raw.find (';');
+        if (semicolon == std::string_view::npos
+            || !decodeEntity (raw.substr (1, semicolon - 1), out)) {
+          out += '&';
+          raw.remove_prefix (1);
+          continue;
+        }
+        raw.remove_prefix (semicolon + 1);
+      }
+    }
+
+    // raw value of attribute name, empty when missing
+    std::string_view attribute (std::string_view attributes, std::string_view name) {
+      std::size_t at = 0;
+      while ((at = attributes.find (name, at)) != std::string_view::npos) {
+        const bool starts = at == 0 || isSpace (attributes[at - 1]);
+        std::size_t i = at + name.size ();
+        at = i;
+        if (!starts) {
+          continue;
+        }
+        while (i < attributes.size () && isSpace (attributes[i])) {
+          ++i;
+        }
+        if (i >= attributes.size () || attributes[i] != '=') {
+          continue;
+        }
+        ++i;
+        while (i < attributes.size () && isSpace (attributes[i])) {
+          ++i;
+        }
+        if (i >= attributes.size () || (attributes[i] != '"' && attributes[i] != '\'')) {
+          continue;
+        }
+        const std::size_t close = attributes.find (attributes[i], i + 1);
+        if (close == std::string_view::npos) {
+          return {};
+        }
+        return attributes.substr (i + 1, close - i - 1);
+      }
+      return {};
+    }
+
+    // part is a strict beginning of whole, the rest may come with the next chunk
+    bool startsOf (std::string_view part, std::string_view whole) {
+      return part.size () < whole.size () && whole.substr (0, part.size ()) == part;
+    }
+
+    bool isItem (std::string_view name) {
+      return name == "item" || name == "entry";
+    }
+  } // namespace
+
+  RssStreamParser::RssStreamParser (OnItem onItem) : onItem_ (std::move (onItem)) {
+  }
+
+  void RssStreamParser::Fields::clear () {
+    arena.clear ();
+    for (Span& span : spans) {
+      span = Span{};
+    }
+  }
+
+  RssStreamParser::Item RssStreamParser::Fields::view () const {
+    auto at = [this] (Field field) {
+      const Span& span = spans[field];
+      return std::string_view (arena).substr (span.begin, span.end - span.begin);
+    };
+    return Item{ at (Title), at (Link), at (Description), at (PubDate), at (Guid) };
+  }
+
+  RssStreamParser::Item RssStreamParser::channel () const {
+    return channel_.view ();
+  }
+
+  bool RssStreamParser::finish () const {
+    return isFeed_;
+  }
+
+  void RssStreamParser::feed (const char* data, std::size_t size) {
+    // complete the carried token with the chunk up to the next '>' first
+    while (!carry_.empty () && size > 0) {
+      const void* gt = std::memchr (data, '>', size);
+      const std::size_t take = gt ? static_cast<const char*> (gt) - data + 1 : size;
+      carry_.append (data, take);
+      data += take;
+      size -= take;
+      carry_.erase (0, parse (carry_.data (), carry_.size ()));
+    }
+    if (carry_.empty ()) {
+      const std::size_t used = parse (data, size);
+      carry_.assign (data + used, size - used);
+    }
+  }
+
+  std::size_t RssStreamParser::parse (const char* data, std::size_t size) {
+    std::size_t i = 0;
+    while (i < size) {
+      const std::string_view rest (data + i, size - i);
+
+      if (state_ == State::Comment || state_ == State::Cdata) {
+        const std::size_t end = rest.find (state_ == State::Comment ? "-->" : "]]>");
+        // the last two bytes may start the terminator
+        const std::size_t upto = end == std::string_view::npos
+                                     ? (rest.size () > 2 ? rest.size () - 2 : 0)
+                                     : end;
+        if (state_ == State::Cdata) {
+          text (rest.data (), upto);
+        }
+        if (end == std::string_view::npos) {
+          return i + upto;
+        }
+        i += end + 3;
+        state_ = State::Text;
+        continue;
+      }
+
+      const std::size_t special = rest.find_first_of ("<&");
+      if (special != 0) {
+        const std::size_t length = std::min (special, rest.size ());
+        text (rest.data (), length);
+        i += length;
+        continue;
+      }
+
+      if (rest[0] == '&') {
+        const std::size_t used = entity (rest.data (), rest.size ());
+        if (used == 0) {
+          return i;
+        }
+        i += used;
+        continue;
+      }
+
+      if (rest.size () > 1 && rest[1] == '!') {
+        if (startsOf (rest, cdataOpen) || startsOf (rest, commentOpen)) {
+          return i;
+        }
+        if (rest.substr (0, cdataOpen.size ()) == cdataOpen) {
+          state_ = State::Cdata;
+          i += cdataOpen.size ();
+          continue;
+        }
+        if (rest.substr (0, commentOpen.size ()) == commentOpen) {
+          state_ = State::Comment;
+          i += commentOpen.size ();
+          continue;
+        }
+      }
+
+      // a whole tag, '>' inside quoted attribute values does not end it
+      char quote = 0;
+      std::size_t end = 1;
+      for (; end < rest.size (); ++end) {
+        const char c = rest[end];
+        if (quote) {
+          quote = c == quote ? 0 : quote;
+        } else if (c == '"' || c == '\'') {
+          quote = c;
+        } else if (c == '>') {
+          break;
+        }
+      }
+      if (end == rest.size ()) {
+        return i;
+      }
+      if (rest.size () > 1 && rest[1] != '?' && rest[1] != '!') {
+        tag (rest.substr (1, end - 1));
+      }
+      i += end + 1;
+    }
+    return i;
+  }
+
+  std::size_t RssStreamParser::entity (const char* data, std::size_t size) {
+    const std::string_view rest (data, std::min (size, maxEntity));
+    const std::size_t semicolon = rest.find (';');
+    if (semicolon == std::string_view::npos) {
+      if (size < maxEntity && rest.find_first_of (" \t\r\n<&", 1) == std::string_view::npos) {
+        return 0; // may still be completed by the next chunk
+      }
+      text (data, 1);
+      return 1;
+    }
+    if (target_) {
+      if (!decodeEntity (rest.substr (1, semicolon - 1), target_->arena)) {
+        target_->arena.append (data, semicolon + 1);
+      }
+    }
+    return semicolon + 1;
+  }
+
+  void RssStreamParser::tag (std::string_view markup) {
+    const bool closing = !markup.empty () && markup[0] == '/';
+    if (closing) {
+      markup.remove_prefix (1);
+    }
+    const bool selfClosing = !markup.empty () && markup.back () == '/';
+    if (selfClosing) {
+      markup.remove_suffix (1);
+    }
+
+    std::size_t nameEnd = 0;
+    while (nameEnd < markup.size () && !isSpace (markup[nameEnd])) {
+      ++nameEnd;
+    }
+    const std::string_view name = markup.substr (0, nameEnd);
+    if (closing) {
+      close (name);
+      return;
+    }
+    open (name, markup.substr (nameEnd));
+    if (selfClosing) {
+      close (name);
+    }
+  }
+
+  void RssStreamParser::open (std::string_view name, std::string_view attributes) {
+    const int depth = depth_++;
+    if (depth == 0) {
+      isFeed_ = name == "rss" || name == "feed" || name == "rdf:RDF";
+      if (name == "feed") {
+        channelDepth_ = 0;
+      }
+      return;
+    }
+    if (target_) {
+      return; // markup inside a captured field, e.g. Atom xhtml content
+    }
+    if (itemDepth_ < 0 && isItem (name)) {
+      itemDepth_ = depth;
+      item_.clear ();
+      return;
+    }
+    if (itemDepth_ < 0 && name == "channel") {
+      channelDepth_ = depth;
+      return;
+    }
+
+    Fields* fields = nullptr;
+    if (itemDepth_ >= 0 && depth == itemDepth_ + 1) {
+      fields = &item_;
+    } else if (itemDepth_ < 0 && channelDepth_ >= 0 && depth == channelDepth_ + 1) {
+      fields = &channel_;
+    }
+    if (!fields) {
+      return;
+    }
+
+    Field field = NoField;
+    if (name == "title") {
+      field = Title;
+    } else if (name == "link") {
+      field = Link;
+    } else if (name == "description" || name == "summary" || name == "subtitle"
+               || name == "content" || name == "content:encoded") {
+      field = Description;
+    } else if (name == "pubDate" || name == "published" || name == "updated"
+               || name == "dc:date") {
+      field = PubDate;
+    } else if (name == "guid" || name == "id") {
+      field = Guid;
+    }
+    if (field == NoField || fields->spans[field].set) {
+      return;
+    }
+
+    Span& span = fields->spans[field];
+    span.begin = fields->arena.size ();
+    const std::string_view href = attribute (attributes, "href");
+    if (field == Link && !href.empty ()) {
+      // Atom links carry the address in href, only the alternate one is the item's page
+      const std::string_view rel = attribute (attributes, "rel");
+      if (!rel.empty () && rel != "alternate") {
+        return;
+      }
+      appendDecoded (fields->arena, href);
+      span.end = fields->arena.size ();
+      span.set = true;
+      return;
+    }
+    target_ = fields;
+    field_ = field;
+    fieldDepth_ = depth;
+  }
+
+  void RssStreamParser::close (std::string_view name) {
+    if (depth_ == 0) {
+      return;
+    }
+    const int depth = --depth_;
+    if (target_ && depth == fieldDepth_) {
+      endCapture ();
+    }
+    if (itemDepth_ >= 0 && depth == itemDepth_ && isItem (name)) {
+      itemDepth_ = -1;
+      ++itemCount_;
+      if (onItem_) {
+        onItem_ (item_.view ());
+      }
+    }
+  }
+
+  void RssStreamParser::text (const char* data, std::size_t size) {
+    if (target_) {
+      target_->arena.append (data, size);
+    }
+  }
+
+  void RssStreamParser::endCapture () {
+    Span& span = target_->spans[field_];
+    span.end = target_->arena.size ();
+    while (span.begin < span.end && isSpace (target_->arena[span.begin])) {
+      ++span.begin;
+    }
+    while (span.end > span.begin && isSpace (target_->arena[span.end - 1])) {
+      --span.end;
+    }
+    span.set = true;
+    target_ = nullptr;
+    field_ = NoField;
+    fieldDepth_ = -1;
+  }
+
+} // namespace dotname
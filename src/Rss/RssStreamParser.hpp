@@ -0,0 +1,97 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#ifndef RSSSTREAMPARSER_HPP
+#define RSSSTREAMPARSER_HPP
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace dotname {
+
+  // Pull parser of RSS 2.0 / 1.0 and Atom feeds fed chunk by chunk.
+  //
+  // Only title, link, description, pubDate and guid (and their Atom
+  // counterparts) of the channel and of every item are kept. Their text is
+  // decoded straight into a per item arena, the rest of the document is
+  // skipped as it streams by. Chunks may split the document anywhere; only an
+  // unfinished tag or entity is carried over, so memory is bounded by the
+  // largest item and not by the feed.
+  class RssStreamParser {
+  public:
+    // Views into the arena, valid until the callback returns
+    struct Item {
+      std::string_view title;
+      std::string_view link;
+      std::string_view description;
+      std::string_view pubDate;
+      std::string_view guid;
+    };
+    using OnItem = std::function<void (const Item&)>;
+
+    explicit RssStreamParser (OnItem onItem);
+    RssStreamParser (const RssStreamParser&) = delete;
+    RssStreamParser& operator= (const RssStreamParser&) = delete;
+
+    void feed (const char* data, std::size_t size);
+    void feed (std::string_view chunk) {
+      feed (chunk.data (), chunk.size ());
+    }
+    // End of the document, false when it was no RSS or Atom feed
+    bool finish () const;
+
+    // Channel (Atom feed) fields, views valid until the next feed ()
+    Item channel () const;
+    std::size_t itemCount () const {
+      return itemCount_;
+    }
+
+  private:
+    enum class State { Text, Comment, Cdata };
+    enum Field { Title, Link, Description, PubDate, Guid, FieldCount, NoField = FieldCount };
+
+    struct Span {
+      std::size_t begin = 0;
+      std::size_t end = 0;
+      bool set = false;
+    };
+    struct Fields {
+      std::string arena;
+      Span spans[FieldCount];
+
+      void clear ();
+      Item view () const;
+    };
+
+    std::size_t parse (const char* data, std::size_t size);
+    std::size_t entity (const char* data, std::size_t size);
+    void tag (std::string_view markup);
+    void open (std::string_view name, std::string_view attributes);
+    void close (std::string_view name);
+    void text (const char* data, std::size_t size);
+    void endCapture ();
+
+    OnItem onItem_;
+    State state_ = State::Text;
+    std::string carry_;
+
+    bool isFeed_ = false;
+    int depth_ = 0;
+    int channelDepth_ = -1;
+    int itemDepth_ = -1;
+
+    // field being captured, NoField when text is skipped
+    Fields* target_ = nullptr;
+    Field field_ = NoField;
+    int fieldDepth_ = -1;
+
+    Fields channel_;
+    Fields item_;
+    std::size_t itemCount_ = 0;
+  };
+
+} // namespace dotname
+
+#endif // RSSSTREAMPARSER_HPP
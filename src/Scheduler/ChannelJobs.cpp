@@ -0,0 +1,238 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include "ChannelJobs.hpp"
+#include "Scheduler.hpp"
+
+#include <Logger/Logger.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace dotname {
+
+  namespace {
+    bool parseNumber (std::string_view text, std::uint32_t& number) {
+      if (text.empty () || text.size () > 9) {
+        return false;
+      }
+      number = 0;
+      for (char c : text) {
+        if (c < '0' || c > '9') {
+          return false;
+        }
+        number = number * 10 + static_cast<std::uint32_t> (c - '0');
+      }
+      return true;
+    }
+  } // namespace
+
+  ChannelJobs::ChannelJobs (std::vector<std::string> names) : names_ (std::move (names)) {
+  }
+
+  bool ChannelJobs::parseSchedule (std::string_view text, Schedule& schedule) {
+    schedule = Schedule{};
+    const std::size_t colon = text.find (':');
+    if (colon != std::string_view::npos) {
+      std::uint32_t hour = 0;
+      std::uint32_t minute = 0;
+      if (!parseNumber (text.substr (0, colon), hour) || text.size () - colon != 3
+          || !parseNumber (text.substr (colon + 1), minute) || hour > 23 || minute > 59) {
+        return false;
+      }
+      schedule.minuteOfDay = static_cast<std::int16_t> (hour * 60 + minute);
+      return true;
+    }
+
+    if (text.size () < 2) {
+      return false;
+    }
+    std::uint32_t unit = 0;
+    const char suffix = text.back ();
+    if (suffix == 's') {
+      unit = 1;
+    } else if (suffix == 'm') {
+      unit = 60;
+    } else if (suffix == 'h') {
+      unit = 60 * 60;
+    } else if (suffix == 'd') {
+      unit = 24 * 60 * 60;
+    } else {
+      return false;
+    }
+    std::uint32_t count = 0;
+    if (!parseNumber (text.substr (0, text.size () - 1), count) || count == 0
+        || count > UINT32_MAX / unit || count * unit < minPeriod) {
+      return false;
+    }
+    schedule.period = count * unit;
+    return true;
+  }
+
+  std::string ChannelJobs::formatSchedule (const Schedule& schedule) {
+    if (schedule.minuteOfDay >= 0) {
+      return fmt::format ("{:02}:{:02}", schedule.minuteOfDay / 60, schedule.minuteOfDay % 60);
+    }
+    const std::uint32_t period = schedule.period;
+    if (period % (24 * 60 * 60) == 0) {
+      return std::to_string (period / (24 * 60 * 60)) + "d";
+    }
+    if (period % (60 * 60) == 0) {
+      return std::to_string (period / (60 * 60)) + "h";
+    }
+    if (period % 60 == 0) {
+      return std::to_string (period / 60) + "m";
+    }
+    return std::to_string (period) + "s";
+  }
+
+  bool ChannelJobs::find (std::string_view name, Job& job) const {
+    for (std::size_t i = 0; i < names_.size (); ++i) {
+      if (names_[i] == name) {
+        job = static_cast<Job> (i);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool ChannelJobs::load (const std::filesystem::path& path, std::time_t now) {
+    std::ifstream file (path);
+    if (!file.is_open ()) {
+      LOG_E_STREAM << "Error: Could not open file " << path << std::endl;
+      return false;
+    }
+
+    std::string line;
+    std::size_t number = 0;
+    while (std::getline (file, line)) {
+      ++number;
+      line = line.substr (0, line.find ('#'));
+      std::istringstream fields (line);
+      std::string channel;
+      std::string name;
+      std::string when;
+      if (!(fields >> channel)) {
+        continue;
+      }
+      Channel id = 0;
+      try {
+        id = std::stoull (channel);
+      } catch (const std::exception&) {
+        id = 0;
+      }
+      Job job = 0;
+      Schedule schedule;
+      if (id == 0 || !(fields >> name >> when) || !find (name, job)
+          || !parseSchedule (when, schedule)) {
+        LOG_W_STREAM << "Warning: " << path << ":" << number
+                     << " is not <channel id> <job> <schedule>" << std::endl;
+        continue;
+      }
+      subscribe (id, job, schedule, now);
+    }
+    return true;
+  }
+
+  bool ChannelJobs::subscribe (Channel channel, Job job, const Schedule& schedule,
+                               std::time_t now) {
+    if (job >= names_.size () || !schedule.valid ()) {
+      return false;
+    }
+    std::lock_guard<std::mutex> lock (mutex_);
+    auto it = std::find_if (rows_.begin (), rows_.end (), [&] (const Row& row) {
+      return row.channel == channel && row.job == job;
+    });
+    if (it == rows_.end ()) {
+      it = rows_.insert (rows_.end (), Row{ channel, 0, 0, -1, job });
+    }
+    it->next = nextRun (schedule, now);
+    it->period = schedule.period;
+    it->minuteOfDay = schedule.minuteOfDay;
+    return true;
+  }
+
+  bool ChannelJobs::unsubscribe (Channel channel, Job job) {
+    std::lock_guard<std::mutex> lock (mutex_);
+    auto it = std::find_if (rows_.begin (), rows_.end (), [&] (const Row& row) {
+      return row.channel == channel && row.job == job;
+    });
+    if (it == rows_.end ()) {
+      return false;
+    }
+    // rows are unordered, the last one fills the gap
+    *it = rows_.back ();
+    rows_.pop_back ();
+    return true;
+  }
+
+  std::size_t ChannelJobs::unsubscribeAll (Channel channel) {
+    std::lock_guard<std::mutex> lock (mutex_);
+    const std::size_t before = rows_.size ();
+    rows_.erase (std::remove_if (rows_.begin (), rows_.end (),
+                                 [channel] (const Row& row) { return row.channel == channel; }),
+                 rows_.end ());
+    return before - rows_.size ();
+  }
+
+  std::vector<std::pair<ChannelJobs::Job, ChannelJobs::Schedule> >
+  ChannelJobs::jobsOf (Channel channel) const {
+    std::vector<std::pair<Job, Schedule> > jobs;
+    std::lock_guard<std::mutex> lock (mutex_);
+    for (const Row& row : rows_) {
+      if (row.channel == channel) {
+        jobs.emplace_back (row.job, Schedule{ row.period, row.minuteOfDay });
+      }
+    }
+    std::sort (jobs.begin (), jobs.end (),
+               [] (const auto& a, const auto& b) { return a.first < b.first; });
+    return jobs;
+  }
+
+  std::size_t ChannelJobs::size () const {
+    std::lock_guard<std::mutex> lock (mutex_);
+    return rows_.size ();
+  }
+
+  std::size_t ChannelJobs::collect (std::time_t now, const Batch& batch) {
+    std::vector<std::vector<Channel> > due (names_.size ());
+    std::size_t count = 0;
+    {
+      std::lock_guard<std::mutex> lock (mutex_);
+      for (Row& row : rows_) {
+        if (row.next > now) {
+          continue;
+        }
+        due[row.job].push_back (row.channel);
+        ++count;
+        // runs missed while the bot was down are not repeated
+        if (row.minuteOfDay >= 0) {
+          row.next = nextRun (Schedule{ row.period, row.minuteOfDay }, now);
+        } else if (row.next + row.period > now) {
+          row.next += row.period;
+        } else {
+          row.next = now + row.period;
+        }
+      }
+    }
+    for (std::size_t job = 0; job < due.size (); ++job) {
+      if (!due[job].empty ()) {
+        batch (static_cast<Job> (job), due[job]);
+      }
+    }
+    return count;
+  }
+
+  std::int64_t ChannelJobs::nextRun (const Schedule& schedule, std::time_t now) {
+    if (schedule.minuteOfDay < 0) {
+      return now;
+    }
+    return now
+           + Scheduler::untilWallClock (schedule.minuteOfDay / 60, schedule.minuteOfDay % 60, now)
+                 .count ();
+  }
+
+} // namespace dotname
@@ -0,0 +1,96 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#ifndef CHANNELJOBS_HPP
+#define CHANNELJOBS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace dotname {
+
+  // Jobs (verse, btc, ...) subscribed by Discord channels, each with its own schedule.
+  //
+  // Subscriptions are 24 byte rows of one flat table and cost no timer or
+  // thread of their own. The owner calls collect () on every tick of a
+  // single scheduler job; the due rows are grouped by job so that each job
+  // builds its message once and fans it out to all its due channels. Times
+  // are wall clock seconds since the epoch. Thread safe.
+  class ChannelJobs {
+  public:
+    using Channel = std::uint64_t;
+    using Job = std::uint8_t;
+    using Batch = std::function<void (Job job, const std::vector<Channel>& channels)>;
+
+    // Every period seconds, or daily at minuteOfDay of the local wall clock
+    struct Schedule {
+      std::uint32_t period = 0;
+      std::int16_t minuteOfDay = -1;
+
+      bool valid () const {
+        return period > 0 || (minuteOfDay >= 0 && minuteOfDay < 24 * 60);
+      }
+    };
+
+    // Job ids are indexes into names
+    explicit ChannelJobs (std::vector<std::string> names);
+    ChannelJobs (const ChannelJobs&) = delete;
+    ChannelJobs& operator= (const ChannelJobs&) = delete;
+
+    // Shortest period a channel may subscribe, e.g. a fortune spawns a process every time
+    static constexpr std::uint32_t minPeriod = 5 * 60;
+
+    // "330s", "30m", "12h", "1d" or a time of day "06:00"; false below minPeriod
+    static bool parseSchedule (std::string_view text, Schedule& schedule);
+    static std::string formatSchedule (const Schedule& schedule);
+
+    // False when name is no job
+    bool find (std::string_view name, Job& job) const;
+    const std::string& name (Job job) const {
+      return names_[job];
+    }
+    std::size_t jobCount () const {
+      return names_.size ();
+    }
+
+    // Subscriptions from lines "<channel id> <job> <schedule>", '#' starts a comment
+    bool load (const std::filesystem::path& path, std::time_t now);
+    // A periodic job is first due at now, a daily one at its next time of day.
+    // Subscribing again only changes the schedule.
+    bool subscribe (Channel channel, Job job, const Schedule& schedule, std::time_t now);
+    bool unsubscribe (Channel channel, Job job);
+    std::size_t unsubscribeAll (Channel channel);
+    std::vector<std::pair<Job, Schedule> > jobsOf (Channel channel) const;
+    std::size_t size () const;
+
+    // Calls batch once per job with the channels due at now and moves them to
+    // their next run; returns the number of due subscriptions
+    std::size_t collect (std::time_t now, const Batch& batch);
+
+  private:
+    struct Row {
+      Channel channel;
+      std::int64_t next;
+      std::uint32_t period;
+      std::int16_t minuteOfDay;
+      Job job;
+    };
+
+    static std::int64_t nextRun (const Schedule& schedule, std::time_t now);
+
+    const std::vector<std::string> names_;
+    mutable std::mutex mutex_;
+    std::vector<Row> rows_;
+  };
+
+} // namespace dotname
+
+#endif // CHANNELJOBS_HPP
@@ -0,0 +1,58 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#ifndef INFLIGHT_HPP
+#define INFLIGHT_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+namespace dotname {
+
+  // Counts requests that have been sent and not answered yet, thread safe.
+  //
+  // Shutdown drains it: new requests are refused and the caller waits a
+  // bounded time for the outstanding ones to be answered.
+  class InFlight {
+  public:
+    // False once draining started, the request must not be sent
+    bool enter () {
+      std::lock_guard<std::mutex> lock (mutex_);
+      if (closed_) {
+        return false;
+      }
+      ++count_;
+      return true;
+    }
+
+    void leave () {
+      std::lock_guard<std::mutex> lock (mutex_);
+      if (count_ != 0 && --count_ == 0) {
+        drained_.notify_all ();
+      }
+    }
+
+    // Refuses further requests and waits for the outstanding ones, false on timeout
+    bool drain (std::chrono::milliseconds timeout) {
+      std::unique_lock<std::mutex> lock (mutex_);
+      closed_ = true;
+      return drained_.wait_for (lock, timeout, [this] { return count_ == 0; });
+    }
+
+    std::size_t count () const {
+      std::lock_guard<std::mutex> lock (mutex_);
+      return count_;
+    }
+
+  private:
+    mutable std::mutex mutex_;
+    std::condition_variable drained_;
+    std::size_t count_ = 0;
+    bool closed_ = false;
+  };
+
+} // namespace dotname
+
+#endif // INFLIGHT_HPP
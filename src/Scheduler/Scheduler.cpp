@@ -0,0 +1,198 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include "Scheduler.hpp"
+
+#include <Logger/Logger.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+namespace dotname {
+
+  Scheduler::Scheduler (std::size_t workers, Clock::duration tick)
+      : tick_ (tick > Clock::duration::zero () ? tick : std::chrono::milliseconds (100)),
+        start_ (Clock::now ()), pool_ (workers), random_ (std::random_device{}()) {
+    thread_ = std::thread (&Scheduler::run, this);
+  }
+
+  Scheduler::~Scheduler () {
+    shutdown (std::chrono::milliseconds::zero ());
+  }
+
+  bool Scheduler::shutdown (std::chrono::milliseconds timeout) {
+    std::lock_guard<std::mutex> once (shutdownMutex_);
+    stop_.requestStop ();
+    {
+      std::lock_guard<std::mutex> lock (mutex_);
+      stopping_ = true;
+      jobs_.clear ();
+    }
+    wake_.notify_all ();
+    if (thread_.joinable ()) {
+      thread_.join ();
+    }
+    return pool_.shutdown (timeout);
+  }
+
+  Scheduler::JobId Scheduler::after (Clock::duration delay, Task task) {
+    auto job = std::make_shared<Job> ();
+    job->task = std::move (task);
+    return add (std::move (job), delay);
+  }
+
+  Scheduler::JobId Scheduler::every (Clock::duration interval, Task task, Clock::duration jitter,
+                                     Clock::duration delay) {
+    if (interval <= Clock::duration::zero ()) {
+      LOG_E_STREAM << "Error: Scheduler interval has to be positive" << std::endl;
+      return noJob;
+    }
+    auto job = std::make_shared<Job> ();
+    job->task = std::move (task);
+    job->interval = interval;
+    job->jitter = jitter;
+    return add (std::move (job), delay);
+  }
+
+  Scheduler::JobId Scheduler::daily (int hour, int minute, Task task, Clock::duration jitter) {
+    if (hour < 0 || hour > 23 || minute < 0 || minute > 59) {
+      LOG_E_STREAM << "Error: Invalid time of day " << hour << ":" << minute << std::endl;
+      return noJob;
+    }
+    auto job = std::make_shared<Job> ();
+    job->task = std::move (task);
+    job->hour = hour;
+    job->minute = minute;
+    job->jitter = jitter;
+    return add (std::move (job), untilWallClock (hour, minute));
+  }
+
+  bool Scheduler::cancel (JobId id) {
+    std::lock_guard<std::mutex> lock (mutex_);
+    return jobs_.erase (id) != 0;
+  }
+
+  std::size_t Scheduler::jobCount () const {
+    std::lock_guard<std::mutex> lock (mutex_);
+    return jobs_.size ();
+  }
+
+  std::chrono::seconds Scheduler::untilWallClock (int hour, int minute) {
+    return untilWallClock (hour, minute, std::time (nullptr));
+  }
+
+  std::chrono::seconds Scheduler::untilWallClock (int hour, int minute, std::time_t now) {
+    std::tm local{};
+#ifdef _WIN32
+    localtime_s (&local, &now);
+#else
+    localtime_r (&now, &local);
+#endif
+    local.tm_hour = hour;
+    local.tm_min = minute;
+    local.tm_sec = 0;
+    local.tm_isdst = -1;
+    std::time_t next = std::mktime (&local);
+    if (next <= now) {
+      local.tm_mday += 1;
+      local.tm_hour = hour;
+      local.tm_min = minute;
+      local.tm_isdst = -1;
+      next = std::mktime (&local);
+    }
+    return std::chrono::seconds (next - now);
+  }
+
+  Scheduler::JobId Scheduler::add (std::shared_ptr<Job> job, Clock::duration delay) {
+    JobId id = noJob;
+    {
+      std::lock_guard<std::mutex> lock (mutex_);
+      if (stopping_) {
+        return noJob;
+      }
+      id = nextId_++;
+      const std::uint64_t due
+          = currentTick () + ticksIn (std::max (delay, Clock::duration::zero ()));
+      schedule (id, *job, due);
+      jobs_.emplace (id, std::move (job));
+    }
+    wake_.notify_one ();
+    return id;
+  }
+
+  void Scheduler::schedule (JobId id, Job& job, std::uint64_t due) {
+    std::uint64_t jitter = 0;
+    if (job.jitter > Clock::duration::zero ()) {
+      jitter = std::uniform_int_distribution<std::uint64_t> (0, ticksIn (job.jitter)) (random_);
+    }
+    job.due = due;
+    // the wheel moves what is already due to its next tick
+    job.expiry = wheel_.add (id, due + jitter);
+  }
+
+  std::uint64_t Scheduler::nextDue (const Job& job) {
+    const std::uint64_t now = currentTick ();
+    if (job.hour >= 0) {
+      return now + ticksIn (untilWallClock (job.hour, job.minute));
+    }
+    // keeps the cadence of due, unless the wheel fell behind by more than an interval
+    const std::uint64_t due = job.due + std::max<std::uint64_t> (ticksIn (job.interval), 1);
+    return due > now ? due : now + 1;
+  }
+
+  void Scheduler::dispatch (JobId id, std::uint64_t expiry) {
+    auto it = jobs_.find (id);
+    // cancelled, or the entry of an earlier schedule
+    if (it == jobs_.end () || it->second->expiry != expiry) {
+      return;
+    }
+    std::shared_ptr<Job> job = it->second;
+    if (job->periodic ()) {
+      schedule (id, *job, nextDue (*job));
+    } else {
+      jobs_.erase (it);
+    }
+
+    if (job->running.exchange (true)) {
+      LOG_W_STREAM << "Warning: Job " << id << " is still running, its turn is skipped"
+                   << std::endl;
+      return;
+    }
+    const bool posted = pool_.post ([job] () {
+      try {
+        job->task ();
+      } catch (const std::exception& e) {
+        LOG_E_STREAM << "Error: " << e.what () << std::endl;
+      }
+      job->running.store (false);
+    });
+    if (!posted) {
+      job->running.store (false);
+    }
+  }
+
+  std::uint64_t Scheduler::ticksIn (Clock::duration duration) const {
+    // rounded up, a job never runs early
+    return static_cast<std::uint64_t> ((duration + tick_ - Clock::duration (1)) / tick_);
+  }
+
+  std::uint64_t Scheduler::currentTick () const {
+    return static_cast<std::uint64_t> ((Clock::now () - start_) / tick_);
+  }
+
+  void Scheduler::run () {
+    std::unique_lock<std::mutex> lock (mutex_);
+    while (!stopping_) {
+      wheel_.advance (currentTick (),
+                      [this] (std::uint64_t id, std::uint64_t expiry) { dispatch (id, expiry); });
+      if (wheel_.size () == 0) {
+        // nothing to tick for until a job is added
+        wake_.wait (lock, [this] { return stopping_ || wheel_.size () != 0; });
+      } else {
+        wake_.wait_until (lock, start_ + tick_ * static_cast<Clock::rep> (wheel_.now () + 1));
+      }
+    }
+  }
+
+} // namespace dotname
@@ -0,0 +1,120 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#ifndef SCHEDULER_HPP
+#define SCHEDULER_HPP
+
+#include "StopToken.hpp"
+#include "TimerWheel.hpp"
+#include "WorkerPool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <unordered_map>
+
+namespace dotname {
+
+  // Runs delayed, periodic and daily jobs on a small worker pool.
+  //
+  // One thread advances a TimerWheel tick by tick and hands due jobs over to
+  // the pool, so a job is added and expired in O(1) however many are
+  // scheduled. Cancelling only forgets the job, its wheel entry is dropped
+  // when it comes due. A periodic job whose previous run has not finished
+  // skips its turn instead of piling up. Thread safe.
+  class Scheduler {
+  public:
+    using Clock = std::chrono::steady_clock;
+    using JobId = std::uint64_t;
+    using Task = std::function<void ()>;
+    static constexpr JobId noJob = 0;
+
+    explicit Scheduler (std::size_t workers = 2,
+                        Clock::duration tick = std::chrono::milliseconds (100));
+    // Shuts down without waiting for the running jobs, then joins the threads
+    ~Scheduler ();
+    Scheduler (const Scheduler&) = delete;
+    Scheduler& operator= (const Scheduler&) = delete;
+
+    JobId after (Clock::duration delay, Task task);
+    // First run after delay, then every interval; each run is postponed by a
+    // random part of jitter so that jobs started together do not fire together
+    JobId every (Clock::duration interval, Task task, Clock::duration jitter = {},
+                 Clock::duration delay = {});
+    // Every day at hour:minute of the local wall clock, recomputed at each run
+    // so that DST changes and clock adjustments are followed
+    JobId daily (int hour, int minute, Task task, Clock::duration jitter = {});
+    // False when the job already finished or was cancelled; a run in progress completes
+    bool cancel (JobId id);
+
+    // Drops every job, requests the running ones to stop and waits for them at
+    // most timeout; false when some are still running. Nothing is scheduled after.
+    bool shutdown (std::chrono::milliseconds timeout);
+    // Stop requested by shutdown, for jobs that run long to return early
+    StopToken stopToken () const {
+      return stop_.token ();
+    }
+
+    std::size_t jobCount () const;
+    Clock::duration tick () const {
+      return tick_;
+    }
+
+    // Time left from now until the next hour:minute of the local wall clock
+    static std::chrono::seconds untilWallClock (int hour, int minute);
+    static std::chrono::seconds untilWallClock (int hour, int minute, std::time_t now);
+
+  private:
+    struct Job {
+      Task task;
+      // zero for a job running once
+      Clock::duration interval{};
+      // daily at hour:minute when hour is not negative
+      int hour = -1;
+      int minute = 0;
+      Clock::duration jitter{};
+      // tick the job is due at without jitter, and with it
+      std::uint64_t due = 0;
+      std::uint64_t expiry = 0;
+      std::atomic<bool> running{ false };
+
+      bool periodic () const {
+        return hour >= 0 || interval > Clock::duration::zero ();
+      }
+    };
+
+    JobId add (std::shared_ptr<Job> job, Clock::duration delay);
+    void schedule (JobId id, Job& job, std::uint64_t due);
+    std::uint64_t nextDue (const Job& job);
+    void dispatch (JobId id, std::uint64_t expiry);
+    std::uint64_t ticksIn (Clock::duration duration) const;
+    std::uint64_t currentTick () const;
+    void run ();
+
+    const Clock::duration tick_;
+    const Clock::time_point start_;
+    WorkerPool pool_;
+    StopSource stop_;
+    std::mutex shutdownMutex_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stopping_ = false;
+    TimerWheel wheel_;
+    std::unordered_map<JobId, std::shared_ptr<Job> > jobs_;
+    JobId nextId_ = 1;
+    std::mt19937_64 random_;
+    std::thread thread_;
+  };
+
+} // namespace dotname
+
+#endif // SCHEDULER_HPP
@@ -0,0 +1,55 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#ifndef STOPTOKEN_HPP
+#define STOPTOKEN_HPP
+
+#include <atomic>
+#include <memory>
+
+namespace dotname {
+
+  // C++17 stand-in for std::stop_source / std::stop_token.
+  //
+  // Long running tasks poll stopRequested () between steps and return early
+  // once their owner shuts down. Tokens stay valid after the source is gone.
+  class StopToken {
+  public:
+    StopToken () = default;
+
+    bool stopRequested () const {
+      return stopped_ && stopped_->load (std::memory_order_acquire);
+    }
+
+  private:
+    friend class StopSource;
+    explicit StopToken (std::shared_ptr<const std::atomic<bool> > stopped)
+        : stopped_ (std::move (stopped)) {
+    }
+
+    std::shared_ptr<const std::atomic<bool> > stopped_;
+  };
+
+  class StopSource {
+  public:
+    StopSource () : stopped_ (std::make_shared<std::atomic<bool> > (false)) {
+    }
+
+    // True for the call that requested the stop first
+    bool requestStop () {
+      return !stopped_->exchange (true, std::memory_order_acq_rel);
+    }
+    bool stopRequested () const {
+      return stopped_->load (std::memory_order_acquire);
+    }
+    StopToken token () const {
+      return StopToken (stopped_);
+    }
+
+  private:
+    std::shared_ptr<std::atomic<bool> > stopped_;
+  };
+
+} // namespace dotname
+
+#endif // STOPTOKEN_HPP
@@ -0,0 +1,112 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#ifndef TIMERWHEEL_HPP
+#define TIMERWHEEL_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dotname {
+
+  // Hierarchical timer wheel over abstract ticks, not thread safe.
+  //
+  // Four levels of 256 slots cover 2^32 ticks. An entry goes to the lowest
+  // level whose higher digits it shares with the current tick, so add is O(1);
+  // when a level's digit turns over, the slot of the next level is cascaded
+  // one level down. Every entry is moved at most three times before it expires.
+  class TimerWheel {
+  public:
+    static constexpr int levelBits = 8;
+    static constexpr std::size_t slotCount = std::size_t (1) << levelBits;
+    static constexpr int levelCount = 4;
+    // the farthest expiry still lands in a top level slot that lies ahead
+    static constexpr std::uint64_t maxDelay
+        = (std::uint64_t (1) << (levelBits * levelCount))
+          - (std::uint64_t (1) << (levelBits * (levelCount - 1)));
+
+    explicit TimerWheel (std::uint64_t now = 0) : now_ (now) {
+    }
+
+    std::uint64_t now () const {
+      return now_;
+    }
+    std::size_t size () const {
+      return size_;
+    }
+
+    // An expiry not after now () expires on the next tick, returns the tick the entry
+    // expires at
+    std::uint64_t add (std::uint64_t id, std::uint64_t expiry) {
+      if (expiry <= now_) {
+        expiry = now_ + 1;
+      } else if (expiry - now_ > maxDelay) {
+        expiry = now_ + maxDelay;
+      }
+      place (Entry{ id, expiry });
+      ++size_;
+      return expiry;
+    }
+
+    // Moves time forward to tick and calls expire (id, expiry) for every due entry in
+    // expiry order. expire may add new entries.
+    template <typename Expire> void advance (std::uint64_t tick, Expire expire) {
+      std::vector<Entry> due;
+      while (now_ < tick) {
+        ++now_;
+        for (int level = levelCount - 1; level > 0; --level) {
+          if ((now_ & ((std::uint64_t (1) << (levelBits * level)) - 1)) == 0) {
+            cascade (level);
+          }
+        }
+
+        due.clear ();
+        due.swap (wheel_[0][digit (now_, 0)]);
+        size_ -= due.size ();
+        for (const Entry& entry : due) {
+          expire (entry.id, entry.expiry);
+        }
+      }
+    }
+
+  private:
+    struct Entry {
+      std::uint64_t id;
+      std::uint64_t expiry;
+    };
+
+    static std::size_t digit (std::uint64_t tick, int level) {
+      return static_cast<std::size_t> ((tick >> (levelBits * level)) & (slotCount - 1));
+    }
+
+    // a and b share all digits above level
+    static bool sameAbove (std::uint64_t a, std::uint64_t b, int level) {
+      return (a >> (levelBits * (level + 1))) == (b >> (levelBits * (level + 1)));
+    }
+
+    void place (const Entry& entry) {
+      int level = 0;
+      while (level < levelCount - 1 && !sameAbove (entry.expiry, now_, level)) {
+        ++level;
+      }
+      wheel_[level][digit (entry.expiry, level)].push_back (entry);
+    }
+
+    void cascade (int level) {
+      std::vector<Entry> entries;
+      entries.swap (wheel_[level][digit (now_, level)]);
+      for (const Entry& entry : entries) {
+        place (entry);
+      }
+    }
+
+    std::array<std::array<std::vector<Entry>, slotCount>, levelCount> wheel_;
+    std::uint64_t now_;
+    std::size_t size_ = 0;
+  };
+
+} // namespace dotname
+
+#endif // TIMERWHEEL_HPP
@@ -0,0 +1,93 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include "WorkerPool.hpp"
+
+#include <Logger/Logger.hpp>
+
+#include <exception>
+#include <utility>
+
+namespace dotname {
+
+  WorkerPool::WorkerPool (std::size_t threads) {
+    threads_.reserve (threads ? threads : 1);
+    for (std::size_t i = 0; i < (threads ? threads : 1); ++i) {
+      threads_.emplace_back (&WorkerPool::run, this);
+    }
+  }
+
+  WorkerPool::~WorkerPool () {
+    shutdown (std::chrono::milliseconds::zero ());
+    for (std::thread& thread : threads_) {
+      thread.join ();
+    }
+  }
+
+  bool WorkerPool::post (Task task) {
+    {
+      std::lock_guard<std::mutex> lock (mutex_);
+      if (stopping_) {
+        return false;
+      }
+      tasks_.push_back (std::move (task));
+    }
+    ready_.notify_one ();
+    return true;
+  }
+
+  bool WorkerPool::shutdown (std::chrono::milliseconds timeout) {
+    std::deque<Task> dropped;
+    std::unique_lock<std::mutex> lock (mutex_);
+    stopping_ = true;
+    dropped.swap (tasks_);
+    ready_.notify_all ();
+    const bool idle = idle_.wait_for (lock, timeout, [this] { return active_ == 0; });
+    const std::size_t running = active_;
+    lock.unlock ();
+
+    if (!dropped.empty ()) {
+      LOG_W_STREAM << "Warning: " << dropped.size () << " queued tasks dropped" << std::endl;
+    }
+    if (!idle && timeout > std::chrono::milliseconds::zero ()) {
+      LOG_W_STREAM << "Warning: " << running << " tasks still running after " << timeout.count ()
+                   << " ms" << std::endl;
+    }
+    return idle;
+  }
+
+  std::size_t WorkerPool::queued () const {
+    std::lock_guard<std::mutex> lock (mutex_);
+    return tasks_.size ();
+  }
+
+  void WorkerPool::run () {
+    for (;;) {
+      Task task;
+      {
+        std::unique_lock<std::mutex> lock (mutex_);
+        ready_.wait (lock, [this] { return stopping_ || !tasks_.empty (); });
+        if (tasks_.empty ()) {
+          return;
+        }
+        task = std::move (tasks_.front ());
+        tasks_.pop_front ();
+        ++active_;
+      }
+      try {
+        task ();
+      } catch (const std::exception& e) {
+        LOG_E_STREAM << "Error: " << e.what () << std::endl;
+      } catch (...) {
+        LOG_E_STREAM << "Error: Unknown exception in a worker task" << std::endl;
+      }
+      // released before the pool learns it is idle, a drained pool holds no captures
+      task = nullptr;
+      std::lock_guard<std::mutex> lock (mutex_);
+      if (--active_ == 0) {
+        idle_.notify_all ();
+      }
+    }
+  }
+
+} // namespace dotname
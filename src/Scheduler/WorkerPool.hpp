@@ -0,0 +1,57 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#ifndef WORKERPOOL_HPP
+#define WORKERPOOL_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dotname {
+
+  // Fixed number of threads running posted tasks in FIFO order.
+  //
+  // Tasks must not throw; what they do throw is logged and dropped. Shutdown
+  // drops the tasks still queued and waits a bounded time for the running
+  // ones; the destructor shuts down and joins the threads.
+  class WorkerPool {
+  public:
+    using Task = std::function<void ()>;
+
+    explicit WorkerPool (std::size_t threads = 2);
+    ~WorkerPool ();
+    WorkerPool (const WorkerPool&) = delete;
+    WorkerPool& operator= (const WorkerPool&) = delete;
+
+    // False after shutdown, the task is not run
+    bool post (Task task);
+    // False when tasks are still running after timeout
+    bool shutdown (std::chrono::milliseconds timeout);
+
+    std::size_t threadCount () const {
+      return threads_.size ();
+    }
+    // Tasks queued and not yet picked up by a thread
+    std::size_t queued () const;
+
+  private:
+    void run ();
+
+    mutable std::mutex mutex_;
+    std::condition_variable ready_;
+    std::condition_variable idle_;
+    std::deque<Task> tasks_;
+    std::size_t active_ = 0;
+    bool stopping_ = false;
+    std::vector<std::thread> threads_;
+  };
+
+} // namespace dotname
+
+#endif // WORKERPOOL_HPP
@@ -0,0 +1,189 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include "Subprocess.hpp"
+
+#include <Logger/Logger.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <thread>
+
+#ifdef _WIN32
+  #include <cstdio>
+#else
+  #include <fcntl.h>
+  #include <poll.h>
+  #include <signal.h>
+  #include <spawn.h>
+  #include <sys/wait.h>
+  #include <unistd.h>
+
+extern char** environ;
+#endif
+
+namespace dotname {
+
+#ifdef _WIN32
+
+  // no posix_spawn, the output is capped but the timeout is not enforced
+  Subprocess::Result Subprocess::run (const std::vector<std::string>& argv,
+                                      const Options& options) {
+    Result result;
+    std::string command;
+    for (const std::string& arg : argv) {
+      command += (command.empty () ? "" : " ") + arg;
+    }
+    FILE* pipe = _popen (command.c_str (), "r");
+    if (!pipe) {
+      return result;
+    }
+    result.started = true;
+    result.output.resize (options.maxBytes);
+    std::size_t size = 0;
+    while (size < options.maxBytes) {
+      const std::size_t got = std::fread (&result.output[size], 1, options.maxBytes - size, pipe);
+      if (got == 0) {
+        break;
+      }
+      size += got;
+    }
+    result.truncated = size == options.maxBytes && std::fgetc (pipe) != EOF;
+    result.output.resize (size);
+    result.exitCode = _pclose (pipe);
+    return result;
+  }
+
+#else
+
+  namespace {
+    using Clock = std::chrono::steady_clock;
+
+    int msUntil (Clock::time_point deadline) {
+      const auto left
+          = std::chrono::duration_cast<std::chrono::milliseconds> (deadline - Clock::now ());
+      return static_cast<int> (std::max<std::chrono::milliseconds::rep> (left.count (), 0));
+    }
+
+    // Reaps pid, killing it once deadline passed; returns the wait status
+    int reap (pid_t pid, Clock::time_point deadline, bool& killed) {
+      int status = 0;
+      for (;;) {
+        const pid_t done = ::waitpid (pid, &status, killed ? 0 : WNOHANG);
+        if (done == pid) {
+          return status;
+        }
+        if (done < 0 && errno != EINTR) {
+          return -1;
+        }
+        if (!killed && Clock::now () >= deadline) {
+          ::kill (pid, SIGKILL);
+          killed = true;
+        } else if (!killed) {
+          std::this_thread::sleep_for (std::chrono::milliseconds (1));
+        }
+      }
+    }
+  } // namespace
+
+  Subprocess::Result Subprocess::run (const std::vector<std::string>& argv,
+                                      const Options& options) {
+    Result result;
+    if (argv.empty ()) {
+      return result;
+    }
+    const Clock::time_point deadline = Clock::now () + options.timeout;
+
+    // the child keeps only the write end, as its stdout; with pipe2 no other thread's
+    // child can inherit either end in between
+    int fds[2];
+  #ifdef __linux__
+    const int piped = ::pipe2 (fds, O_CLOEXEC);
+  #else
+    const int piped = ::pipe (fds);
+    if (piped == 0) {
+      ::fcntl (fds[0], F_SETFD, FD_CLOEXEC);
+      ::fcntl (fds[1], F_SETFD, FD_CLOEXEC);
+    }
+  #endif
+    if (piped != 0) {
+      LOG_E_STREAM << "Error: pipe: " << std::strerror (errno) << std::endl;
+      return result;
+    }
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init (&actions);
+    posix_spawn_file_actions_addopen (&actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+    posix_spawn_file_actions_adddup2 (&actions, fds[1], STDOUT_FILENO);
+    posix_spawn_file_actions_addopen (&actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+
+    std::vector<char*> args;
+    for (const std::string& arg : argv) {
+      args.push_back (const_cast<char*> (arg.c_str ()));
+    }
+    args.push_back (nullptr);
+
+    pid_t pid = 0;
+    const int spawned = ::posix_spawnp (&pid, args[0], &actions, nullptr, args.data (), environ);
+    posix_spawn_file_actions_destroy (&actions);
+    ::close (fds[1]);
+    if (spawned != 0) {
+      LOG_E_STREAM << "Error: Could not run " << argv[0] << ": " << std::strerror (spawned)
+                   << std::endl;
+      ::close (fds[0]);
+      return result;
+    }
+    result.started = true;
+
+    // read straight into the one allocation, up to the cap
+    result.output.resize (options.maxBytes);
+    std::size_t size = 0;
+    bool killed = false;
+    for (;;) {
+      pollfd readable{ fds[0], POLLIN, 0 };
+      const int ready = ::poll (&readable, 1, msUntil (deadline));
+      if (ready < 0 && errno == EINTR) {
+        continue;
+      }
+      if (ready <= 0) {
+        result.timedOut = ready == 0;
+        break;
+      }
+      char overflow;
+      char* into = size < options.maxBytes ? &result.output[size] : &overflow;
+      const std::size_t room = size < options.maxBytes ? options.maxBytes - size : 1;
+      const ssize_t got = ::read (fds[0], into, room);
+      if (got < 0 && errno == EINTR) {
+        continue;
+      }
+      if (got <= 0) {
+        break;
+      }
+      if (into == &overflow) {
+        result.truncated = true;
+        break;
+      }
+      size += static_cast<std::size_t> (got);
+    }
+    ::close (fds[0]);
+    result.output.resize (size);
+
+    if (result.timedOut || result.truncated) {
+      ::kill (pid, SIGKILL);
+      killed = true;
+    }
+    // the output closed, the program gets what is left of the timeout to exit
+    const int status = reap (pid, deadline, killed);
+    if (killed && !result.truncated) {
+      result.timedOut = true;
+    }
+    if (status >= 0 && WIFEXITED (status)) {
+      result.exitCode = WEXITSTATUS (status);
+    }
+    return result;
+  }
+
+#endif
+
+} // namespace dotname
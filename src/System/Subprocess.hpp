@@ -0,0 +1,51 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#ifndef SUBPROCESS_HPP
+#define SUBPROCESS_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace dotname {
+
+  // Runs a program and collects its standard output, never for longer than a timeout.
+  //
+  // The program is started with posix_spawnp (searched in PATH, no shell),
+  // stdin and stderr go to /dev/null. Its output is read through a pipe into a
+  // buffer allocated once at maxBytes; a program that writes more, hangs or
+  // keeps running after closing its output is killed. Stateless, any thread.
+  class Subprocess {
+  public:
+    struct Options {
+      std::chrono::milliseconds timeout{ 2000 };
+      std::size_t maxBytes = 4096;
+    };
+
+    struct Result {
+      // false when the program could not be started, e.g. it is not installed
+      bool started = false;
+      bool timedOut = false;
+      // more than maxBytes were written, output holds the first maxBytes
+      bool truncated = false;
+      // -1 when the program was killed by a signal
+      int exitCode = -1;
+      std::string output;
+
+      bool ok () const {
+        return started && !timedOut && exitCode == 0;
+      }
+    };
+
+    // argv[0] is the program
+    static Result run (const std::vector<std::string>& argv, const Options& options);
+    static Result run (const std::vector<std::string>& argv) {
+      return run (argv, Options ());
+    }
+  };
+
+} // namespace dotname
+
+#endif // SUBPROCESS_HPP
@@ -0,0 +1,165 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include "SystemInfo.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string_view>
+#include <utility>
+
+namespace dotname {
+
+  namespace {
+    std::string trim (std::string_view text) {
+      const auto first = text.find_first_not_of (" \t\r\n\"");
+      if (first == std::string_view::npos) {
+        return {};
+      }
+      const auto last = text.find_last_not_of (" \t\r\n\"");
+      return std::string (text.substr (first, last - first + 1));
+    }
+
+    std::string firstLine (const std::filesystem::path& path) {
+      std::ifstream file (path);
+      std::string line;
+      std::getline (file, line);
+      return trim (line);
+    }
+
+    // Value of the first "key<separator>value" line, empty when there is none
+    std::string valueOf (const std::filesystem::path& path, std::string_view key,
+                         char separator) {
+      std::ifstream file (path);
+      std::string line;
+      while (std::getline (file, line)) {
+        const auto at = line.find (separator);
+        if (at != std::string::npos && trim (std::string_view (line).substr (0, at)) == key) {
+          return trim (std::string_view (line).substr (at + 1));
+        }
+      }
+      return {};
+    }
+
+    std::uint64_t kibOf (const std::filesystem::path& meminfo, std::string_view key) {
+      // "MemTotal:       16318412 kB"
+      const std::string value = valueOf (meminfo, key, ':');
+      return value.empty () ? 0 : std::strtoull (value.c_str (), nullptr, 10);
+    }
+
+    std::string gib (std::uint64_t kib) {
+      return fmt::format ("{:.2f} GiB", static_cast<double> (kib) / (1024.0 * 1024.0));
+    }
+  } // namespace
+
+  SystemInfo::SystemInfo (std::filesystem::path root, Clock::duration ttl)
+      : root_ (std::move (root)), ttl_ (ttl), static_ (readStatic ()) {
+  }
+
+  SystemInfo::Static SystemInfo::readStatic () const {
+    Static info;
+    info.host = firstLine (root_ / "proc/sys/kernel/hostname");
+    info.os = valueOf (root_ / "etc/os-release", "PRETTY_NAME", '=');
+    info.kernel = firstLine (root_ / "proc/sys/kernel/osrelease");
+
+    std::ifstream cpuinfo (root_ / "proc/cpuinfo");
+    std::string line;
+    while (std::getline (cpuinfo, line)) {
+      const auto at = line.find (':');
+      if (at == std::string::npos) {
+        continue;
+      }
+      const std::string key = trim (std::string_view (line).substr (0, at));
+      if (key == "processor") {
+        ++info.cores;
+      } else if (info.cpu.empty () && (key == "model name" || key == "Model")) {
+        info.cpu = trim (std::string_view (line).substr (at + 1));
+      }
+    }
+    return info;
+  }
+
+  SystemInfo::Dynamic SystemInfo::readDynamic () const {
+    Dynamic info;
+    std::ifstream uptime (root_ / "proc/uptime");
+    if (!(uptime >> info.uptimeSec)) {
+      info.uptimeSec = -1.0;
+    }
+    std::ifstream loadavg (root_ / "proc/loadavg");
+    if (!(loadavg >> info.load[0] >> info.load[1] >> info.load[2])) {
+      info.load[0] = info.load[1] = info.load[2] = -1.0;
+    }
+
+    const std::filesystem::path meminfo = root_ / "proc/meminfo";
+    info.memTotalKiB = kibOf (meminfo, "MemTotal");
+    info.memAvailableKiB = kibOf (meminfo, "MemAvailable");
+
+    // millidegrees
+    std::ifstream temperature (root_ / "sys/class/thermal/thermal_zone0/temp");
+    long milli = 0;
+    if (temperature >> milli) {
+      info.temperature = static_cast<double> (milli) / 1000.0;
+    }
+    return info;
+  }
+
+  SystemInfo::Dynamic SystemInfo::dynamics () {
+    std::lock_guard<std::mutex> lock (mutex_);
+    const Clock::time_point now = Clock::now ();
+    if (!read_ || now - readAt_ >= ttl_) {
+      dynamic_ = readDynamic ();
+      readAt_ = now;
+      read_ = true;
+    }
+    return dynamic_;
+  }
+
+  std::string SystemInfo::formatUptime (double seconds) {
+    const auto total = static_cast<long long> (seconds);
+    const long long days = total / 86400;
+    const long long hours = total % 86400 / 3600;
+    const long long mins = total % 3600 / 60;
+    std::string text;
+    if (days) {
+      text += fmt::format ("{} day{}, ", days, days == 1 ? "" : "s");
+    }
+    if (days || hours) {
+      text += fmt::format ("{} hour{}, ", hours, hours == 1 ? "" : "s");
+    }
+    return text + fmt::format ("{} min{}", mins, mins == 1 ? "" : "s");
+  }
+
+  std::string SystemInfo::render () {
+    const Dynamic dynamic = dynamics ();
+    std::ostringstream report;
+    auto line = [&report] (const char* key, const std::string& value) {
+      if (!value.empty ()) {
+        report << key << ": " << value << "\n";
+      }
+    };
+
+    line ("Host", static_.host);
+    line ("OS", static_.os);
+    line ("Kernel", static_.kernel);
+    line ("Uptime", dynamic.uptimeSec < 0 ? "" : formatUptime (dynamic.uptimeSec));
+    line ("CPU", static_.cores ? fmt::format ("{} ({})", static_.cpu, static_.cores)
+                               : static_.cpu);
+    line ("Load", dynamic.load[0] < 0 ? ""
+                                      : fmt::format ("{:.2f} {:.2f} {:.2f}", dynamic.load[0],
+                                                     dynamic.load[1], dynamic.load[2]));
+    if (dynamic.memTotalKiB) {
+      const std::uint64_t used = dynamic.memTotalKiB - std::min (dynamic.memAvailableKiB,
+                                                                 dynamic.memTotalKiB);
+      line ("Memory", fmt::format ("{} / {} ({}%)", gib (used), gib (dynamic.memTotalKiB),
+                                   used * 100 / dynamic.memTotalKiB));
+    }
+    line ("Temperature",
+          dynamic.temperature < 0 ? "" : fmt::format ("{:.1f} °C", dynamic.temperature));
+    return report.str ();
+  }
+
+} // namespace dotname
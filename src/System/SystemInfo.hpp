@@ -0,0 +1,71 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#ifndef SYSTEMINFO_HPP
+#define SYSTEMINFO_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+
+namespace dotname {
+
+  // Facts fastfetch / neofetch report, read from /proc and /sys without a process.
+  //
+  // Host, OS, kernel and CPU do not change while the bot runs and are read
+  // once by the constructor; uptime, load, memory and temperature are read
+  // again once they are older than ttl. A fact the system does not expose is
+  // left out of the report. Linux only, elsewhere the report is nearly empty.
+  // Thread safe.
+  class SystemInfo {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Static {
+      std::string host;
+      std::string os;
+      std::string kernel;
+      std::string cpu;
+      unsigned cores = 0;
+    };
+    struct Dynamic {
+      double uptimeSec = -1.0;
+      double load[3] = { -1.0, -1.0, -1.0 };
+      std::uint64_t memTotalKiB = 0;
+      std::uint64_t memAvailableKiB = 0;
+      // degrees Celsius, negative when there is no thermal zone
+      double temperature = -1.0;
+    };
+
+    // root replaces "/" in every path read, for tests
+    explicit SystemInfo (std::filesystem::path root = "/",
+                         Clock::duration ttl = std::chrono::seconds (5));
+
+    const Static& statics () const {
+      return static_;
+    }
+    Dynamic dynamics ();
+    // "Key: value" lines in the order of fastfetch's archey preset
+    std::string render ();
+
+    static std::string formatUptime (double seconds);
+
+  private:
+    Static readStatic () const;
+    Dynamic readDynamic () const;
+
+    const std::filesystem::path root_;
+    const Clock::duration ttl_;
+    const Static static_;
+
+    std::mutex mutex_;
+    Dynamic dynamic_;
+    Clock::time_point readAt_{};
+    bool read_ = false;
+  };
+
+} // namespace dotname
+
+#endif // SYSTEMINFO_HPP
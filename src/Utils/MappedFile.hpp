@@ -0,0 +1,134 @@
+#ifndef MAPPEDFILE_HPP
+#define MAPPEDFILE_HPP
+
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#ifdef _WIN32
+// no mmap, the file content is read into an owned buffer instead
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace DotNameUtils {
+
+  namespace FileIO {
+
+    // Read-only view of a whole file, mapped once and released on destruction
+    class MappedFile {
+    public:
+      MappedFile () = default;
+      explicit MappedFile (const std::filesystem::path& filePath) {
+        open (filePath);
+      }
+      ~MappedFile () {
+        close ();
+      }
+
+      MappedFile (const MappedFile&) = delete;
+      MappedFile& operator= (const MappedFile&) = delete;
+      MappedFile (MappedFile&& other) noexcept {
+        *this = std::move (other);
+      }
+      MappedFile& operator= (MappedFile&& other) noexcept {
+        if (this != &other) {
+          close ();
+          data_ = other.data_;
+          size_ = other.size_;
+#ifdef _WIN32
+          buffer_ = std::move (other.buffer_);
+          data_ = buffer_.data ();
+#endif
+          other.data_ = nullptr;
+          other.size_ = 0;
+        }
+        return *this;
+      }
+
+      bool open (const std::filesystem::path& filePath) {
+        close ();
+#ifdef _WIN32
+        std::ifstream file (filePath, std::ios::in | std::ios::binary);
+        if (!file.is_open ()) {
+          return false;
+        }
+        buffer_.assign (std::istreambuf_iterator<char> (file), std::istreambuf_iterator<char> ());
+        data_ = buffer_.data ();
+        size_ = buffer_.size ();
+        return true;
+#else
+        int fd = ::open (filePath.c_str (), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+          return false;
+        }
+        struct stat st;
+        if (::fstat (fd, &st) != 0) {
+          ::close (fd);
+          return false;
+        }
+        size_ = static_cast<std::size_t> (st.st_size);
+        if (size_ == 0) {
+          ::close (fd);
+          return true;
+        }
+        void* addr = ::mmap (nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close (fd);
+        if (addr == MAP_FAILED) {
+          size_ = 0;
+          return false;
+        }
+        ::madvise (addr, size_, MADV_WILLNEED);
+        data_ = static_cast<const char*> (addr);
+        return true;
+#endif
+      }
+
+      void close () {
+#ifdef _WIN32
+        buffer_.clear ();
+        buffer_.shrink_to_fit ();
+#else
+        if (data_ != nullptr) {
+          ::munmap (const_cast<char*> (data_), size_);
+        }
+#endif
+        data_ = nullptr;
+        size_ = 0;
+      }
+
+      bool isOpen () const {
+        return data_ != nullptr;
+      }
+      const char* data () const {
+        return data_;
+      }
+      std::size_t size () const {
+        return size_;
+      }
+      std::string_view view () const {
+        return std::string_view (data_, size_);
+      }
+
+    private:
+      const char* data_ = nullptr;
+      std::size_t size_ = 0;
+#ifdef _WIN32
+      std::string buffer_;
+#endif
+    };
+
+  } // namespace FileIO
+
+} // namespace DotNameUtils
+
+#endif // MAPPEDFILE_HPP
@@ -2,9 +2,11 @@
 // Copyright (c) 2024-2025 Tomáš Mark
 
 #include "MyDpp/MyDpp.hpp"
+#include "Bible/VerseIndex.hpp"
 #include "Logger/Logger.hpp"
 #include "Utils/Utils.hpp"
 
+#include <chrono>
 #include <cxxopts.hpp>
 #include <filesystem>
 #include <fstream>
@@ -27,6 +29,9 @@ namespace AppContext {
 
 std::unique_ptr<dotname::MyDpp> uniqueLib;
 
+// handlesArguments did all there was to do, runApp exits with 0 right away
+constexpr int argumentsDone = -1;
+
 int handlesArguments (int argc, const char* argv[]) {
   try {
     auto options = std::make_unique<cxxopts::Options> (argv[0], AppContext::standaloneName);
@@ -38,6 +43,10 @@ int handlesArguments (int argc, const char* argv[]) {
                              cxxopts::value<bool> ()->default_value ("false"));
     options->add_options () ("2,log2file", "Log to file",
                              cxxopts::value<bool> ()->default_value ("false"));
+    options->add_options () ("3,index", "Build verse index next to the assets only",
+                             cxxopts::value<bool> ()->default_value ("false"));
+    options->add_options () ("4,log2json", "Log JSON records to file, one per line",
+                             cxxopts::value<bool> ()->default_value ("false"));
     const auto result = options->parse (argc, argv);
 
     if (result.count ("help")) {
@@ -45,11 +54,37 @@ int handlesArguments (int argc, const char* argv[]) {
       return 0;
     }
 
+    // a week of daily files at most, each up to 10 MiB before it is compressed
+    RotatingFile::Policy policy;
+    policy.maxBytes = 10 * 1024 * 1024;
+    policy.maxAge = std::chrono::hours (24);
+    policy.retain = 7;
+    policy.gzip = true;
+    policy.fsyncInterval = std::chrono::seconds (5);
+
     if (result["log2file"].as<bool> ()) {
-      LOG.enableFileLogging (std::string (AppContext::standaloneName) + ".log");
+      LOG.enableFileLogging (std::string (AppContext::standaloneName) + ".log", policy);
       LOG_D_STREAM << "Logging to file enabled [-2]" << std::endl;
     }
 
+    if (result["log2json"].as<bool> ()) {
+      LOG.enableJsonLogging (std::string (AppContext::standaloneName) + ".jsonl", policy);
+      LOG_D_STREAM << "Logging JSON records to file enabled [-4]" << std::endl;
+    }
+
+    // used by ../cmake/tmplt-assets.cmake to prebuild kralicky.idx
+    if (result["index"].as<bool> ()) {
+      const std::filesystem::path bibleText = AppContext::assetsPath / "kralicky.txt";
+      dotname::VerseIndex verseIndex;
+      if (!verseIndex.load (bibleText)
+          || !PathUtils::fileExists (dotname::VerseIndex::indexPathFor (bibleText))) {
+        LOG_E_STREAM << "Error: Could not build verse index for " << bibleText << std::endl;
+        return 1;
+      }
+      LOG_I_STREAM << "Verse index ready [-3]" << std::endl;
+      return argumentsDone;
+    }
+
     if (!result.count ("omit")) {
       // uniqueLib = std::make_unique<dotname::DotNameLib> ();
       uniqueLib = std::make_unique<dotname::MyDpp> (AppContext::assetsPath);
@@ -95,6 +130,8 @@ int runApp (int argc, const char* argv[]) {
 
   LOG.noHeader (true);
   LOG.setSkipLine (false);
+  // D++ debug events and command threads only queue their lines
+  LOG.enableAsync ();
   LOG_I_STREAM << "Starting " << AppContext::standaloneName << " ..." << std::endl;
 
 #ifdef EMSCRIPTEN
@@ -104,7 +141,11 @@ int runApp (int argc, const char* argv[]) {
   LOG_I_STREAM << " ⤷ Emscripten C++ with pthreads support" << std::endl;
 #endif
 
-  if (handlesArguments (argc, argv) != 0) {
+  const int handled = handlesArguments (argc, argv);
+  if (handled == argumentsDone) {
+    return 0;
+  }
+  if (handled != 0) {
     return 1;
   }
 
@@ -0,0 +1,96 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include <Scheduler/ChannelJobs.hpp>
+#include <gtest/gtest.h>
+
+#include <ctime>
+#include <map>
+#include <string>
+#include <vector>
+
+using dotname::ChannelJobs;
+
+TEST (ChannelJobs, ParsesSchedules) {
+  ChannelJobs::Schedule schedule;
+  EXPECT_TRUE (ChannelJobs::parseSchedule ("12h", schedule));
+  EXPECT_EQ (schedule.period, 12u * 3600);
+  EXPECT_EQ (ChannelJobs::formatSchedule (schedule), "12h");
+  EXPECT_TRUE (ChannelJobs::parseSchedule ("330s", schedule));
+  EXPECT_EQ (ChannelJobs::formatSchedule (schedule), "330s");
+  EXPECT_TRUE (ChannelJobs::parseSchedule ("5m", schedule));
+  EXPECT_TRUE (ChannelJobs::parseSchedule ("06:05", schedule));
+  EXPECT_EQ (schedule.minuteOfDay, 6 * 60 + 5);
+  EXPECT_EQ (ChannelJobs::formatSchedule (schedule), "06:05");
+
+  for (const char* wrong : { "", "h", "0m", "12", "12x", "-1h", "24:00", "6:5", "1:2:3",
+                             "1s", "299s", "4m" }) {
+    EXPECT_FALSE (ChannelJobs::parseSchedule (wrong, schedule)) << wrong;
+  }
+}
+
+TEST (ChannelJobs, FansOutDueChannelsPerJob) {
+  ChannelJobs jobs ({ "verse", "btc" });
+  ChannelJobs::Job verse = 0;
+  ChannelJobs::Job btc = 0;
+  ASSERT_TRUE (jobs.find ("verse", verse));
+  ASSERT_TRUE (jobs.find ("btc", btc));
+  EXPECT_FALSE (jobs.find ("czk", btc));
+  ASSERT_TRUE (jobs.find ("btc", btc));
+
+  const std::time_t start = 1700000000;
+  ChannelJobs::Schedule hourly;
+  ChannelJobs::Schedule daily;
+  ASSERT_TRUE (ChannelJobs::parseSchedule ("1h", hourly));
+  ASSERT_TRUE (ChannelJobs::parseSchedule ("1d", daily));
+  for (ChannelJobs::Channel channel = 1; channel <= 1000; ++channel) {
+    EXPECT_TRUE (jobs.subscribe (channel, verse, hourly, start));
+  }
+  EXPECT_TRUE (jobs.subscribe (7, btc, daily, start));
+  EXPECT_TRUE (jobs.subscribe (7, btc, hourly, start)); // only reschedules
+  EXPECT_EQ (jobs.size (), 1001u);
+
+  std::map<ChannelJobs::Job, std::size_t> batches;
+  auto count = [&] (ChannelJobs::Job job, const std::vector<ChannelJobs::Channel>& channels) {
+    batches[job] += channels.size ();
+  };
+  EXPECT_EQ (jobs.collect (start, count), 1001u);
+  EXPECT_EQ (batches[verse], 1000u);
+  EXPECT_EQ (batches[btc], 1u);
+
+  batches.clear ();
+  EXPECT_EQ (jobs.collect (start + 3599, count), 0u);
+  EXPECT_TRUE (jobs.unsubscribe (7, verse));
+  EXPECT_FALSE (jobs.unsubscribe (7, verse));
+  EXPECT_EQ (jobs.collect (start + 3600, count), 1000u);
+  EXPECT_EQ (batches[verse], 999u);
+
+  // a bot that was down for a day runs a missed job once
+  EXPECT_EQ (jobs.collect (start + 90000, count), 1000u);
+  EXPECT_EQ (jobs.collect (start + 90001, count), 0u);
+
+  EXPECT_EQ (jobs.jobsOf (7).size (), 1u);
+  EXPECT_EQ (jobs.unsubscribeAll (7), 1u);
+  EXPECT_TRUE (jobs.jobsOf (7).empty ());
+  EXPECT_FALSE (jobs.subscribe (7, 5, hourly, start));
+}
+
+TEST (ChannelJobs, RunsDailyJobsAtTimeOfDay) {
+  ChannelJobs jobs ({ "sunriset" });
+  ChannelJobs::Schedule morning;
+  ASSERT_TRUE (ChannelJobs::parseSchedule ("06:00", morning));
+  const std::time_t start = 1700000000;
+  jobs.subscribe (1, 0, morning, start);
+
+  std::time_t ran = 0;
+  for (std::time_t now = start; now < start + 2 * 86400 && ran == 0; now += 60) {
+    jobs.collect (now, [&] (ChannelJobs::Job, const std::vector<ChannelJobs::Channel>&) {
+      ran = now;
+    });
+  }
+  ASSERT_NE (ran, 0);
+  std::tm local{};
+  localtime_r (&ran, &local);
+  EXPECT_EQ (local.tm_hour, 6);
+  EXPECT_EQ (local.tm_min, 0);
+}
@@ -0,0 +1,60 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include <Discord/CommandLatency.hpp>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using dotname::CommandLatency;
+using namespace std::chrono_literals;
+
+TEST (CommandLatency, PercentilesAreBucketBoundsCappedByMax) {
+  CommandLatency latency;
+  EXPECT_EQ (latency.summary ("btc").count, 0u);
+
+  for (int i = 0; i < 98; ++i) {
+    latency.record ("btc", 3ms);
+  }
+  latency.record ("btc", 2s);
+  latency.record ("btc", 2500ms);
+
+  const CommandLatency::Summary btc = latency.summary ("btc");
+  EXPECT_EQ (btc.count, 100u);
+  // 3000 us lands in the bucket below 4096 us
+  EXPECT_EQ (btc.p50, 4096us);
+  // the 99th sample is 2 s, its bucket ends at 2^21 us
+  EXPECT_EQ (btc.p99, 2097152us);
+  EXPECT_EQ (btc.max, 2500ms);
+
+  latency.record ("ping", 0us);
+  latency.record ("ping", -5us);
+  const CommandLatency::Summary ping = latency.summary ("ping");
+  EXPECT_EQ (ping.count, 2u);
+  EXPECT_EQ (ping.p99, 0us);
+}
+
+TEST (CommandLatency, SummariesAreByNameAndThreadSafe) {
+  CommandLatency latency;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back ([&latency, t] () {
+      for (int i = 0; i < 1000; ++i) {
+        latency.record (t % 2 ? "fortune" : "bot", std::chrono::microseconds (i));
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join ();
+  }
+
+  const auto all = latency.summaries ();
+  ASSERT_EQ (all.size (), 2u);
+  EXPECT_EQ (all[0].first, "bot");
+  EXPECT_EQ (all[1].first, "fortune");
+  EXPECT_EQ (all[0].second.count, 2000u);
+  EXPECT_EQ (all[1].second.max, 999us);
+  EXPECT_EQ (all[1].second.p50, 512us);
+}
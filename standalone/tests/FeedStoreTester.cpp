@@ -0,0 +1,99 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include <Rss/FeedStore.hpp>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+struct Item {
+  std::string title;
+  std::string link;
+  std::string pubDate;
+  std::string guid;
+};
+
+static std::vector<std::string> newestTitles (const dotname::FeedStore<Item>& store) {
+  std::vector<std::string> titles;
+  store.forEachNewest ([&] (const Item& item) {
+    titles.push_back (item.title);
+    return true;
+  });
+  return titles;
+}
+
+TEST (FeedStore, ParsesPubDates) {
+  EXPECT_EQ (dotname::parsePubDate ("Thu, 01 Jan 1970 00:00:00 GMT"), 0);
+  EXPECT_EQ (dotname::parsePubDate ("Sat, 07 Sep 2002 09:42:31 GMT"), 1031391751);
+  EXPECT_EQ (dotname::parsePubDate ("Sat, 07 Sep 2002 11:42:31 +0200"), 1031391751);
+  EXPECT_EQ (dotname::parsePubDate ("7 Sep 02 09:42 GMT"), 1031391720);
+  EXPECT_EQ (dotname::parsePubDate ("2002-09-07T09:42:31Z"), 1031391751);
+  EXPECT_EQ (dotname::parsePubDate ("2002-09-07T11:42:31.250+02:00"), 1031391751);
+  EXPECT_EQ (dotname::parsePubDate ("yesterday"), 0);
+  EXPECT_EQ (dotname::parsePubDate (""), 0);
+}
+
+TEST (FeedStore, MergesNewItemsOnly) {
+  dotname::FeedStore<Item> store (10);
+  std::vector<Item> feed{ { "b", "l/b", "Tue, 02 Jan 2024 10:00:00 GMT", "g/b" },
+                          { "a", "l/a", "Mon, 01 Jan 2024 10:00:00 GMT", "g/a" } };
+  EXPECT_EQ (store.merge (feed), 2u);
+  EXPECT_EQ (store.merge (feed), 0u);
+
+  // the next poll brings one new item on top, a guid-less one is keyed by its link
+  feed.insert (feed.begin (), Item{ "c", "l/c", "Wed, 03 Jan 2024 10:00:00 GMT", "" });
+  std::vector<Item> added;
+  EXPECT_EQ (store.merge (feed, &added), 1u);
+  ASSERT_EQ (added.size (), 1u);
+  EXPECT_EQ (added[0].title, "c");
+  EXPECT_EQ (store.merge (feed), 0u);
+  EXPECT_EQ (newestTitles (store), (std::vector<std::string>{ "c", "b", "a" }));
+}
+
+TEST (FeedStore, KeepsNewestWithinCapacity) {
+  dotname::FeedStore<Item> store (3);
+  std::vector<Item> feed; // newest first, as feeds list them
+  for (int day = 1; day <= 5; ++day) {
+    const std::string d = std::to_string (day);
+    feed.insert (feed.begin (), { d, "l/" + d, "0" + d + " Jan 2024 10:00:00 GMT", "g/" + d });
+  }
+  EXPECT_EQ (store.merge (feed), 3u);
+  EXPECT_EQ (store.size (), 3u);
+  EXPECT_EQ (newestTitles (store), (std::vector<std::string>{ "5", "4", "3" }));
+
+  // evicted and out of order items
+  const Item late{ "3.5", "l/x", "03 Jan 2024 12:00:00 GMT", "g/x" };
+  EXPECT_EQ (store.merge ({ feed.back (), late }), 1u);
+  EXPECT_EQ (newestTitles (store), (std::vector<std::string>{ "5", "4", "3.5" }));
+
+  // an evicted item that comes back is not merged again
+  EXPECT_EQ (store.merge ({ { "6", "l/3", "06 Jan 2024 10:00:00 GMT", "g/3" } }), 0u);
+
+  int visited = 0;
+  store.forEachNewest ([&] (const Item&) { return ++visited < 2; });
+  EXPECT_EQ (visited, 2);
+}
+
+TEST (FeedStore, SettlesOnDatelessFeedLargerThanCapacity) {
+  dotname::FeedStore<Item> store (64);
+  std::vector<Item> feed;
+  for (int i = 0; i < 100; ++i) {
+    const std::string n = std::to_string (i);
+    feed.push_back ({ n, "l/" + n, "", "g/" + n });
+  }
+  EXPECT_EQ (store.merge (feed), 100u);
+  EXPECT_EQ (store.size (), 64u);
+  for (int poll = 0; poll < 3; ++poll) {
+    EXPECT_EQ (store.merge (feed), 0u);
+  }
+
+  // a new item still gets in, ahead of the dated past
+  feed.insert (feed.begin (), Item{ "new", "l/new", "", "g/new" });
+  feed.push_back ({ "dated", "l/dated", "Mon, 01 Jan 2024 10:00:00 GMT", "g/dated" });
+  std::vector<Item> added;
+  EXPECT_EQ (store.merge (feed, &added), 1u);
+  ASSERT_EQ (added.size (), 1u);
+  EXPECT_EQ (added[0].title, "new");
+  EXPECT_EQ (newestTitles (store).size (), 64u);
+}
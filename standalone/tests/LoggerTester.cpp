@@ -0,0 +1,228 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include <Logger/JsonWriter.hpp>
+#include <Logger/LogRing.hpp>
+#include <Logger/Logger.hpp>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST (LogRing, KeepsOrderAndCapacity) {
+  LogRing<std::string> ring (3);
+  EXPECT_EQ (ring.capacity (), 4u);
+  EXPECT_TRUE (ring.empty ());
+
+  for (int i = 0; i < 4; ++i) {
+    std::string value = std::to_string (i);
+    EXPECT_TRUE (ring.tryPush (value));
+  }
+  std::string full = "full";
+  EXPECT_FALSE (ring.tryPush (full));
+  EXPECT_EQ (full, "full");
+
+  std::string value;
+  for (int round = 0; round < 3; ++round) {
+    ASSERT_TRUE (ring.tryPop (value));
+    std::string again = value;
+    EXPECT_TRUE (ring.tryPush (again));
+  }
+  const char* expected[] = { "3", "0", "1", "2" };
+  for (const char* text : expected) {
+    ASSERT_TRUE (ring.tryPop (value));
+    EXPECT_EQ (value, text);
+  }
+  EXPECT_FALSE (ring.tryPop (value));
+  EXPECT_TRUE (ring.empty ());
+}
+
+TEST (LogRing, ManyProducersOneConsumer) {
+  constexpr int producers = 4;
+  constexpr int perProducer = 20000;
+  LogRing<int> ring (64);
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p) {
+    threads.emplace_back ([&ring, p] () {
+      for (int i = 0; i < perProducer; ++i) {
+        int value = p * perProducer + i;
+        while (!ring.tryPush (value)) {
+          std::this_thread::yield ();
+        }
+      }
+    });
+  }
+
+  // every producer's values arrive complete and in its order
+  std::vector<int> next (producers, 0);
+  int value = 0;
+  for (int received = 0; received < producers * perProducer;) {
+    if (!ring.tryPop (value)) {
+      std::this_thread::yield ();
+      continue;
+    }
+    const int producer = value / perProducer;
+    ASSERT_EQ (value % perProducer, next[producer]);
+    ++next[producer];
+    ++received;
+  }
+  for (std::thread& thread : threads) {
+    thread.join ();
+  }
+  EXPECT_TRUE (ring.empty ());
+}
+
+TEST (Logger, AsyncWritesEveryRecordToFile) {
+  const std::filesystem::path path
+      = std::filesystem::temp_directory_path () / "MyDppLoggerTester.log";
+  std::filesystem::remove (path);
+  // the app under test may have switched it on already
+  LOG.disableAsync ();
+  ASSERT_TRUE (LOG.enableFileLogging (path.string ()));
+  ASSERT_TRUE (LOG.enableAsync (16, Logger::Overflow::Block));
+  EXPECT_FALSE (LOG.enableAsync ());
+  EXPECT_TRUE (LOG.isAsync ());
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back ([t] () {
+      for (int i = 0; i < 100; ++i) {
+        LOG_I_MSG (fmt::format ("record {} {}", t, i));
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join ();
+  }
+  LOG.flush ();
+  LOG.disableAsync ();
+  EXPECT_FALSE (LOG.isAsync ());
+  LOG.disableFileLogging ();
+  EXPECT_EQ (LOG.droppedRecords (), 0u);
+
+  std::ifstream file (path);
+  std::string line;
+  std::size_t records = 0;
+  while (std::getline (file, line)) {
+    if (line.find ("record ") != std::string::npos) {
+      ++records;
+    }
+  }
+  EXPECT_EQ (records, 400u);
+  std::filesystem::remove (path);
+}
+
+TEST (Logger, DisabledLevelsEvaluateNothing) {
+  const Logger::Level level = LOG.getLevel ();
+  LOG.setLevel (Logger::Level::LOG_WARNING);
+  EXPECT_FALSE (LOG.isEnabled (Logger::Level::LOG_INFO));
+  EXPECT_TRUE (LOG.isEnabled (Logger::Level::LOG_ERROR));
+
+  int evaluated = 0;
+  auto costly = [&evaluated] () {
+    ++evaluated;
+    return std::string ("costly");
+  };
+  LOG_I_STREAM << costly () << std::endl;
+  LOG_I_MSG (costly ());
+  LOG_I_FMT ("{} {}", costly (), 42);
+  LOG_D_FMT ("{}", costly ());
+  EXPECT_EQ (evaluated, 0);
+
+  // an unbraced if still pairs with its own else
+  bool elseTaken = false;
+  if (evaluated != 0)
+    LOG_W_STREAM << costly () << std::endl;
+  else
+    elseTaken = true;
+  EXPECT_TRUE (elseTaken);
+  LOG.setLevel (level);
+}
+
+TEST (Logger, TimestampsWithSubsecondPrecision) {
+  const auto now = std::chrono::system_clock::now ();
+  const auto second = std::chrono::floor<std::chrono::seconds> (now);
+
+  LOG.setTimePrecision (Logger::TimePrecision::Seconds);
+  const Logger::Timestamp seconds = LOG.timestamp (second + std::chrono::microseconds (7654));
+  ASSERT_EQ (seconds.size, 19u);
+  EXPECT_EQ (seconds.view ()[2], '-');
+  EXPECT_EQ (seconds.view ()[13], ':');
+
+  LOG.setTimePrecision (Logger::TimePrecision::Milliseconds);
+  const Logger::Timestamp millis = LOG.timestamp (second + std::chrono::microseconds (7654));
+  EXPECT_EQ (millis.view (), std::string (seconds.view ()) + ".007");
+
+  LOG.setTimePrecision (Logger::TimePrecision::Microseconds);
+  const Logger::Timestamp micros = LOG.timestamp (second + std::chrono::microseconds (7654));
+  EXPECT_EQ (micros.view (), std::string (seconds.view ()) + ".007654");
+
+  // the cached second is formatted again once it changes
+  const Logger::Timestamp next = LOG.timestamp (second + std::chrono::seconds (1));
+  EXPECT_NE (next.view ().substr (0, 19), seconds.view ());
+  LOG.setTimePrecision (Logger::TimePrecision::Seconds);
+}
+
+TEST (JsonWriter, EscapesAndFormatsValues) {
+  std::string out;
+  JsonWriter<std::string> json (out);
+  json.begin ();
+  json.string ("text", "say \"hi\"\\\n\t\x01 ěšč");
+  json.number ("signed", std::int64_t (-42));
+  json.number ("unsigned", std::uint64_t (18446744073709551615u));
+  json.number ("real", 0.5);
+  json.number ("nan", std::nan (""));
+  json.boolean ("flag", true);
+  json.end ();
+  EXPECT_EQ (out, "{\"text\":\"say \\\"hi\\\"\\\\\\n\\t\\u0001 ěšč\",\"signed\":-42,"
+                  "\"unsigned\":18446744073709551615,\"real\":0.5,\"nan\":null,\"flag\":true}");
+}
+
+TEST (Logger, JsonRecordsWithFields) {
+  LOG.disableAsync ();
+  const std::filesystem::path path
+      = std::filesystem::temp_directory_path () / "MyDppLoggerTester.jsonl";
+  std::filesystem::remove (path);
+  ASSERT_TRUE (LOG.enableJsonLogging (path.string ()));
+
+  const std::string command = "bible";
+  const bool skipLine = Logger::isSkipLine ();
+  Logger::setSkipLine (false);
+  testing::internal::CaptureStdout ();
+  LOG_I_KV ("Command handled", { "command", command }, { "ms", 12 }, { "deferred", false });
+  const std::string console = testing::internal::GetCapturedStdout ();
+  Logger::setSkipLine (skipLine);
+  // the fields end the console line, the next record starts on its own
+  EXPECT_NE (console.find ("Command handled command=bible ms=12 deferred=false"),
+             std::string::npos);
+  ASSERT_FALSE (console.empty ());
+  EXPECT_EQ (console.back (), '\n');
+  LOG_W_MSG ("no \"fields\"");
+  LOG_I_STREAM << "streamed" << std::endl;
+  LOG.disableJsonLogging ();
+
+  std::ifstream file (path);
+  std::string line;
+  ASSERT_TRUE (std::getline (file, line));
+  EXPECT_EQ (line.rfind ("{\"ts_ns\":", 0), 0u);
+  EXPECT_NE (line.find ("\"level\":\"INF\",\"caller\":\""), std::string::npos);
+  EXPECT_NE (line.find ("TestBody"), std::string::npos);
+  EXPECT_NE (line.find ("\"thread\":"), std::string::npos);
+  EXPECT_NE (line.find ("\"msg\":\"Command handled\",\"command\":\"bible\",\"ms\":12,"
+                        "\"deferred\":false}"),
+             std::string::npos);
+  ASSERT_TRUE (std::getline (file, line));
+  EXPECT_NE (line.find ("\"level\":\"WRN\""), std::string::npos);
+  EXPECT_NE (line.find ("\"msg\":\"no \\\"fields\\\"\"}"), std::string::npos);
+  ASSERT_TRUE (std::getline (file, line));
+  EXPECT_NE (line.find ("\"msg\":\"streamed\"}"), std::string::npos);
+  EXPECT_FALSE (std::getline (file, line));
+  file.close ();
+  std::filesystem::remove (path);
+}
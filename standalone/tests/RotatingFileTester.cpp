@@ -0,0 +1,156 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include <Logger/RotatingFile.hpp>
+#include <gtest/gtest.h>
+#include <zlib.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace {
+  std::filesystem::path freshDir (const char* name) {
+    const std::filesystem::path dir = std::filesystem::temp_directory_path () / name;
+    std::filesystem::remove_all (dir);
+    std::filesystem::create_directories (dir);
+    return dir;
+  }
+
+  std::string contentOf (const std::filesystem::path& path) {
+    std::ifstream file (path, std::ios::binary);
+    return std::string (std::istreambuf_iterator<char> (file), std::istreambuf_iterator<char> ());
+  }
+
+  std::string gunzip (const std::filesystem::path& path) {
+    gzFile file = gzopen (path.string ().c_str (), "rb");
+    std::string content;
+    char chunk[256];
+    int got = 0;
+    while (file && (got = gzread (file, chunk, sizeof (chunk))) > 0) {
+      content.append (chunk, static_cast<std::size_t> (got));
+    }
+    if (file) {
+      gzclose (file);
+    }
+    return content;
+  }
+} // namespace
+
+TEST (RotatingFile, BuffersUntilFlush) {
+  const std::filesystem::path dir = freshDir ("MyDppRotatingFileBuffer");
+  const std::filesystem::path path = dir / "bot.log";
+  RotatingFile::Policy policy;
+  policy.bufferBytes = 16;
+  RotatingFile file;
+  ASSERT_TRUE (file.open (path, policy));
+
+  EXPECT_TRUE (file.write ("0123456789"));
+  EXPECT_EQ (contentOf (path), "");
+  // does not fit the buffer, the buffered part goes out first
+  EXPECT_TRUE (file.write ("abcdefghij"));
+  EXPECT_EQ (contentOf (path), "0123456789");
+  EXPECT_TRUE (file.flush ());
+  EXPECT_EQ (contentOf (path), "0123456789abcdefghij");
+
+  // larger than the buffer, written at once
+  EXPECT_TRUE (file.write (std::string (40, 'x')));
+  EXPECT_EQ (contentOf (path).size (), 60u);
+  file.close ();
+  EXPECT_FALSE (file.is_open ());
+  EXPECT_FALSE (file.write ("closed"));
+  std::filesystem::remove_all (dir);
+}
+
+TEST (RotatingFile, RotatesBySizeAndRetains) {
+  const std::filesystem::path dir = freshDir ("MyDppRotatingFileSize");
+  const std::filesystem::path path = dir / "bot.log";
+  RotatingFile::Policy policy;
+  policy.maxBytes = 10;
+  policy.retain = 2;
+  RotatingFile file;
+  ASSERT_TRUE (file.open (path, policy));
+
+  for (const char* line : { "first\n", "second\n", "third\n", "fourth\n" }) {
+    EXPECT_TRUE (file.write (line));
+  }
+  file.close ();
+
+  EXPECT_EQ (contentOf (path), "fourth\n");
+  EXPECT_EQ (contentOf (file.rotatedPath (1)), "third\n");
+  EXPECT_EQ (contentOf (file.rotatedPath (2)), "second\n");
+  EXPECT_FALSE (std::filesystem::exists (file.rotatedPath (3)));
+
+  // an existing file counts towards the limit
+  ASSERT_TRUE (file.open (path, policy));
+  EXPECT_TRUE (file.write ("fifth\n"));
+  file.close ();
+  EXPECT_EQ (contentOf (path), "fifth\n");
+  EXPECT_EQ (contentOf (file.rotatedPath (1)), "fourth\n");
+  std::filesystem::remove_all (dir);
+}
+
+TEST (RotatingFile, GzipsRotatedFiles) {
+  const std::filesystem::path dir = freshDir ("MyDppRotatingFileGzip");
+  const std::filesystem::path path = dir / "bot.log";
+  RotatingFile::Policy policy;
+  policy.maxBytes = 100;
+  policy.retain = 3;
+  policy.gzip = true;
+  policy.fsyncInterval = std::chrono::milliseconds (0);
+  RotatingFile file;
+  ASSERT_TRUE (file.open (path, policy));
+
+  const std::string first (80, 'a');
+  const std::string second (80, 'b');
+  const std::string third (40, 'c');
+  EXPECT_TRUE (file.write (first));
+  EXPECT_TRUE (file.write (second));
+  EXPECT_TRUE (file.write (third));
+  file.close ();
+
+  EXPECT_EQ (file.rotatedPath (1).filename (), "bot.log.1.gz");
+  EXPECT_EQ (gunzip (file.rotatedPath (1)), second);
+  EXPECT_EQ (gunzip (file.rotatedPath (2)), first);
+  EXPECT_FALSE (std::filesystem::exists (dir / "bot.log.1"));
+  EXPECT_EQ (contentOf (path), third);
+  std::filesystem::remove_all (dir);
+}
+
+TEST (RotatingFile, AgeSurvivesReopening) {
+  const std::filesystem::path dir = freshDir ("MyDppRotatingFileAge");
+  const std::filesystem::path path = dir / "bot.log";
+  RotatingFile::Policy policy;
+  policy.maxAge = std::chrono::hours (1);
+  policy.retain = 2;
+  RotatingFile file;
+  ASSERT_TRUE (file.open (path, policy));
+  EXPECT_TRUE (file.write ("old\n"));
+  file.close ();
+
+  // reopened after a restart, a file written two hours ago is rotated
+  const auto twoHoursAgo
+      = std::filesystem::file_time_type::clock::now () - std::chrono::hours (2);
+  std::filesystem::last_write_time (path, twoHoursAgo);
+  ASSERT_TRUE (file.open (path, policy));
+  EXPECT_TRUE (file.write ("new\n"));
+  file.close ();
+  EXPECT_EQ (contentOf (file.rotatedPath (1)), "old\n");
+  EXPECT_EQ (contentOf (path), "new\n");
+
+  // written just now, but the last rotation was two hours ago
+  std::filesystem::last_write_time (file.rotatedPath (1), twoHoursAgo);
+  ASSERT_TRUE (file.open (path, policy));
+  EXPECT_TRUE (file.write ("newer\n"));
+  file.close ();
+  EXPECT_EQ (contentOf (file.rotatedPath (1)), "new\n");
+  EXPECT_EQ (contentOf (path), "newer\n");
+
+  // a fresh rotation starts the count again
+  ASSERT_TRUE (file.open (path, policy));
+  EXPECT_TRUE (file.write ("newest\n"));
+  file.close ();
+  EXPECT_EQ (contentOf (path), "newer\nnewest\n");
+  std::filesystem::remove_all (dir);
+}
@@ -0,0 +1,104 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include <Rss/RssStreamParser.hpp>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace {
+  const std::string rss = R"(<?xml version="1.0" encoding="UTF-8"?>
+<!DOCTYPE rss>
+<rss version="2.0" xmlns:atom="http://www.w3.org/2005/Atom">
+  <channel>
+    <title>Root.cz - články</title>
+    <atom:link href="https://www.root.cz/rss/clanky/" rel="self" />
+    <link>https://www.root.cz/</link>
+    <description>Informace nejen ze světa Linuxu</description>
+    <!-- <item><title>commented out</title></item> -->
+    <item>
+      <title>Kernel &amp; GCC &#x1F427; &#269;esky</title>
+      <link>https://www.root.cz/clanky/kernel/</link>
+      <description><![CDATA[<p>Nový <b>kernel</b> ]] vyšel</p>]]></description>
+      <pubDate>Mon, 06 Jan 2025 10:00:00 +0100</pubDate>
+      <guid isPermaLink="true">https://www.root.cz/clanky/kernel/</guid>
+    </item>
+    <item>
+      <title>Druhý článek</title>
+      <link>https://www.root.cz/clanky/druhy/</link>
+      <description>&lt;p&gt;text&lt;/p&gt; &unknown; a & b</description>
+    </item>
+  </channel>
+</rss>
+)";
+
+  std::string show (const dotname::RssStreamParser::Item& item) {
+    return std::string (item.title) + "|" + std::string (item.link) + "|"
+           + std::string (item.description) + "|" + std::string (item.pubDate) + "|"
+           + std::string (item.guid);
+  }
+
+  std::vector<std::string> parseInChunks (const std::string& document, std::size_t chunk,
+                                          std::string* channel = nullptr) {
+    std::vector<std::string> items;
+    dotname::RssStreamParser parser (
+        [&] (const dotname::RssStreamParser::Item& item) { items.push_back (show (item)); });
+    for (std::size_t at = 0; at < document.size (); at += chunk) {
+      parser.feed (std::string_view (document).substr (at, chunk));
+    }
+    EXPECT_TRUE (parser.finish ());
+    if (channel) {
+      *channel = show (parser.channel ());
+    }
+    return items;
+  }
+} // namespace
+
+TEST (RssStreamParser, ParsesRssItems) {
+  std::string channel;
+  const std::vector<std::string> items = parseInChunks (rss, rss.size (), &channel);
+  EXPECT_EQ (channel, "Root.cz - články|https://www.root.cz/|Informace nejen ze světa Linuxu||");
+  ASSERT_EQ (items.size (), 2u);
+  EXPECT_EQ (items[0], "Kernel & GCC 🐧 česky|https://www.root.cz/clanky/kernel/|"
+                       "<p>Nový <b>kernel</b> ]] vyšel</p>|Mon, 06 Jan 2025 10:00:00 +0100|"
+                       "https://www.root.cz/clanky/kernel/");
+  EXPECT_EQ (items[1], "Druhý článek|https://www.root.cz/clanky/druhy/|"
+                       "<p>text</p> &unknown; a & b||");
+}
+
+TEST (RssStreamParser, AnySplitGivesTheSameItems) {
+  const std::vector<std::string> whole = parseInChunks (rss, rss.size ());
+  for (std::size_t chunk = 1; chunk < 40; ++chunk) {
+    EXPECT_EQ (parseInChunks (rss, chunk), whole) << "chunk " << chunk;
+  }
+}
+
+TEST (RssStreamParser, ParsesAtomEntries) {
+  const std::string atom = R"(<feed xmlns="http://www.w3.org/2005/Atom">
+  <title type="text">Blog</title>
+  <link rel="self" href="https://example.org/feed.atom"/>
+  <link href="https://example.org/"/>
+  <entry>
+    <title>Atom &lt;3</title>
+    <link rel="enclosure" href="https://example.org/a.mp3"/>
+    <link rel="alternate" href="https://example.org/a?x=1&amp;y=2"/>
+    <id>urn:uuid:1</id>
+    <updated>2025-01-06T10:00:00Z</updated>
+    <content type="xhtml"><div>Hello <em>world</em></div></content>
+  </entry>
+</feed>)";
+  std::string channel;
+  const std::vector<std::string> items = parseInChunks (atom, 7, &channel);
+  EXPECT_EQ (channel, "Blog|https://example.org/|||");
+  ASSERT_EQ (items.size (), 1u);
+  EXPECT_EQ (items[0], "Atom <3|https://example.org/a?x=1&y=2|Hello world|"
+                       "2025-01-06T10:00:00Z|urn:uuid:1");
+}
+
+TEST (RssStreamParser, RejectsOtherDocuments) {
+  dotname::RssStreamParser parser (nullptr);
+  parser.feed ("<html><body><item>not a feed</item></body></html>");
+  EXPECT_FALSE (parser.finish ());
+  EXPECT_EQ (parser.itemCount (), 1u);
+}
@@ -0,0 +1,152 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include <Discord/SendQueue.hpp>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using dotname::SendQueue;
+using namespace std::chrono_literals;
+
+// Discord stand-in that holds the answers until the test gives them
+struct ManualDiscord {
+  struct Request {
+    SendQueue::Channel channel;
+    std::string content;
+    SendQueue::Answered answered;
+  };
+  std::mutex mutex;
+  std::vector<Request> requests;
+
+  SendQueue::Send send () {
+    return [this] (SendQueue::Channel channel, const std::string& content,
+                   SendQueue::Answered answered) {
+      std::lock_guard<std::mutex> lock (mutex);
+      requests.push_back (Request{ channel, content, std::move (answered) });
+    };
+  }
+  // Waits for the count-th request
+  bool waitFor (std::size_t count) {
+    for (int i = 0; i < 2000; ++i) {
+      {
+        std::lock_guard<std::mutex> lock (mutex);
+        if (requests.size () >= count) {
+          return true;
+        }
+      }
+      std::this_thread::sleep_for (1ms);
+    }
+    return false;
+  }
+  Request at (std::size_t index) {
+    std::lock_guard<std::mutex> lock (mutex);
+    return requests.at (index);
+  }
+  std::size_t count () {
+    std::lock_guard<std::mutex> lock (mutex);
+    return requests.size ();
+  }
+};
+
+SendQueue::Answer ok (int remaining = 5) {
+  SendQueue::Answer answer;
+  answer.status = 200;
+  answer.remaining = remaining;
+  answer.resetAfter = 1.0;
+  return answer;
+}
+
+TEST (SendQueue, CoalescesMessagesWaitingForTheirChannel) {
+  ManualDiscord discord;
+  SendQueue queue (discord.send (), 20);
+  ASSERT_TRUE (queue.push (1, "first"));
+  ASSERT_TRUE (discord.waitFor (1));
+
+  // the channel has one request in flight, the rest waits and is joined
+  queue.push (1, "a");
+  queue.push (1, "b\n");
+  queue.push (1, "c");
+  queue.push (1, "too long to be joined");
+  EXPECT_EQ (queue.pending (), 3u);
+  discord.at (0).answered (ok ());
+
+  ASSERT_TRUE (discord.waitFor (2));
+  EXPECT_EQ (discord.at (1).content, "a\nb\nc");
+  discord.at (1).answered (ok ());
+  ASSERT_TRUE (discord.waitFor (3));
+  EXPECT_EQ (discord.at (2).content, "too long to be joined");
+  discord.at (2).answered (ok ());
+
+  EXPECT_TRUE (queue.shutdown (1s));
+  EXPECT_EQ (queue.stats ().sent, 3u);
+  EXPECT_EQ (queue.stats ().coalesced, 2u);
+  EXPECT_FALSE (queue.push (1, "late"));
+}
+
+TEST (SendQueue, ServesInteractionsBeforeScheduledPosts) {
+  ManualDiscord discord;
+  SendQueue queue (discord.send ());
+  queue.push (1, "blocker");
+  ASSERT_TRUE (discord.waitFor (1));
+  queue.push (1, "scheduled", SendQueue::Lane::Scheduled);
+  queue.push (1, "interaction", SendQueue::Lane::Interaction);
+  discord.at (0).answered (ok ());
+
+  ASSERT_TRUE (discord.waitFor (2));
+  EXPECT_EQ (discord.at (1).content, "interaction");
+  discord.at (1).answered (ok ());
+  ASSERT_TRUE (discord.waitFor (3));
+  EXPECT_EQ (discord.at (2).content, "scheduled");
+  discord.at (2).answered (ok ());
+  EXPECT_TRUE (queue.shutdown (1s));
+}
+
+TEST (SendQueue, WaitsForBucketResetAndRetriesRateLimited) {
+  ManualDiscord discord;
+  SendQueue queue (discord.send ());
+  queue.push (1, "one");
+  ASSERT_TRUE (discord.waitFor (1));
+  queue.push (1, "two");
+  queue.push (2, "other channel");
+  // channel 1 is out of requests for 50 ms, channel 2 is not held up
+  SendQueue::Answer empty = ok (0);
+  empty.resetAfter = 0.05;
+  const auto answeredAt = std::chrono::steady_clock::now ();
+  discord.at (0).answered (empty);
+  ASSERT_TRUE (discord.waitFor (2));
+  EXPECT_EQ (discord.at (1).content, "other channel");
+  discord.at (1).answered (ok ());
+
+  ASSERT_TRUE (discord.waitFor (3));
+  EXPECT_GE (std::chrono::steady_clock::now () - answeredAt, 45ms);
+  EXPECT_EQ (discord.at (2).content, "two");
+  SendQueue::Answer limited;
+  limited.status = 429;
+  limited.retryAfter = 0.01;
+  discord.at (2).answered (limited);
+
+  ASSERT_TRUE (discord.waitFor (4));
+  EXPECT_EQ (discord.at (3).content, "two");
+  discord.at (3).answered (ok ());
+  EXPECT_TRUE (queue.shutdown (1s));
+  EXPECT_EQ (queue.stats ().rateLimited, 1u);
+  EXPECT_EQ (queue.stats ().sent, 3u);
+}
+
+TEST (SendQueue, ShutdownIsBoundedByTimeout) {
+  ManualDiscord discord;
+  SendQueue queue (discord.send ());
+  queue.push (1, "never answered");
+  ASSERT_TRUE (discord.waitFor (1));
+  const auto start = std::chrono::steady_clock::now ();
+  EXPECT_FALSE (queue.shutdown (20ms));
+  EXPECT_LT (std::chrono::steady_clock::now () - start, 1s);
+  discord.at (0).answered (ok ());
+  EXPECT_EQ (queue.pending (), 0u);
+}
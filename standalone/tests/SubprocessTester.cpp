@@ -0,0 +1,62 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include <System/Subprocess.hpp>
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+using dotname::Subprocess;
+using namespace std::chrono_literals;
+
+#ifndef _WIN32
+
+TEST (Subprocess, CollectsOutputAndExitCode) {
+  const Subprocess::Result echo = Subprocess::run ({ "echo", "Hello", "DSDotBot" });
+  EXPECT_TRUE (echo.ok ());
+  EXPECT_EQ (echo.output, "Hello DSDotBot\n");
+  EXPECT_FALSE (echo.truncated);
+
+  // arguments are not interpreted by a shell
+  const Subprocess::Result quoted = Subprocess::run ({ "echo", "$HOME;", "`id`" });
+  EXPECT_EQ (quoted.output, "$HOME; `id`\n");
+
+  const Subprocess::Result failed = Subprocess::run ({ "sh", "-c", "echo partial; exit 3" });
+  EXPECT_TRUE (failed.started);
+  EXPECT_FALSE (failed.ok ());
+  EXPECT_EQ (failed.exitCode, 3);
+  EXPECT_EQ (failed.output, "partial\n");
+
+  const Subprocess::Result missing = Subprocess::run ({ "dsdotbot-no-such-program" });
+  EXPECT_FALSE (missing.started);
+  EXPECT_FALSE (missing.ok ());
+}
+
+TEST (Subprocess, KillsProgramsThatHangOrWriteTooMuch) {
+  Subprocess::Options options;
+  options.timeout = 200ms;
+  const auto start = std::chrono::steady_clock::now ();
+  const Subprocess::Result hung = Subprocess::run ({ "sh", "-c", "echo started; sleep 10" },
+                                                   options);
+  EXPECT_LT (std::chrono::steady_clock::now () - start, 5s);
+  EXPECT_TRUE (hung.timedOut);
+  EXPECT_EQ (hung.exitCode, -1);
+  EXPECT_EQ (hung.output, "started\n");
+
+  // closing stdout does not get a program more time
+  const Subprocess::Result lingering
+      = Subprocess::run ({ "sh", "-c", "exec >/dev/null; sleep 10" }, options);
+  EXPECT_TRUE (lingering.timedOut);
+  EXPECT_LT (std::chrono::steady_clock::now () - start, 5s);
+
+  options.timeout = 5s;
+  options.maxBytes = 1000;
+  const Subprocess::Result endless = Subprocess::run ({ "yes" }, options);
+  EXPECT_TRUE (endless.truncated);
+  EXPECT_FALSE (endless.timedOut);
+  ASSERT_EQ (endless.output.size (), 1000u);
+  EXPECT_EQ (endless.output.substr (0, 4), "y\ny\n");
+  EXPECT_LT (std::chrono::steady_clock::now () - start, 5s);
+}
+
+#endif
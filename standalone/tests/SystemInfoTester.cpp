@@ -0,0 +1,85 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include <System/SystemInfo.hpp>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using dotname::SystemInfo;
+using namespace std::chrono_literals;
+
+namespace {
+  void write (const std::filesystem::path& path, const std::string& content) {
+    std::filesystem::create_directories (path.parent_path ());
+    std::ofstream (path) << content;
+  }
+
+  // Fake "/" with what a small x86 machine exposes
+  std::filesystem::path fakeRoot () {
+    const std::filesystem::path root
+        = std::filesystem::temp_directory_path () / "MyDppSystemInfoTester";
+    std::filesystem::remove_all (root);
+    write (root / "proc/sys/kernel/hostname", "dotbot\n");
+    write (root / "proc/sys/kernel/osrelease", "6.1.0-28-amd64\n");
+    write (root / "etc/os-release", "NAME=\"Debian GNU/Linux\"\n"
+                                    "PRETTY_NAME=\"Debian GNU/Linux 12 (bookworm)\"\n");
+    write (root / "proc/cpuinfo", "processor\t: 0\nmodel name\t: Intel(R) N100\n\n"
+                                  "processor\t: 1\nmodel name\t: Intel(R) N100\n");
+    write (root / "proc/uptime", "273661.52 1059283.17\n");
+    write (root / "proc/loadavg", "0.08 0.12 0.10 1/312 4242\n");
+    write (root / "proc/meminfo", "MemTotal:        8388608 kB\n"
+                                  "MemFree:         1048576 kB\n"
+                                  "MemAvailable:    6291456 kB\n");
+    write (root / "sys/class/thermal/thermal_zone0/temp", "45500\n");
+    return root;
+  }
+} // namespace
+
+TEST (SystemInfo, RendersFactsOfProcAndSys) {
+  const std::filesystem::path root = fakeRoot ();
+  SystemInfo info (root);
+
+  EXPECT_EQ (info.statics ().host, "dotbot");
+  EXPECT_EQ (info.statics ().cpu, "Intel(R) N100");
+  EXPECT_EQ (info.statics ().cores, 2u);
+  EXPECT_EQ (info.render (), "Host: dotbot\n"
+                             "OS: Debian GNU/Linux 12 (bookworm)\n"
+                             "Kernel: 6.1.0-28-amd64\n"
+                             "Uptime: 3 days, 4 hours, 1 min\n"
+                             "CPU: Intel(R) N100 (2)\n"
+                             "Load: 0.08 0.12 0.10\n"
+                             "Memory: 2.00 GiB / 8.00 GiB (25%)\n"
+                             "Temperature: 45.5 °C\n");
+  std::filesystem::remove_all (root);
+}
+
+TEST (SystemInfo, CachesDynamicFactsForTtl) {
+  const std::filesystem::path root = fakeRoot ();
+  SystemInfo cached (root, 1h);
+  SystemInfo uncached (root, 0s);
+  EXPECT_DOUBLE_EQ (cached.dynamics ().load[0], 0.08);
+  EXPECT_DOUBLE_EQ (uncached.dynamics ().load[0], 0.08);
+
+  write (root / "proc/loadavg", "2.50 1.00 0.50 3/312 4243\n");
+  EXPECT_DOUBLE_EQ (cached.dynamics ().load[0], 0.08);
+  EXPECT_DOUBLE_EQ (uncached.dynamics ().load[0], 2.50);
+
+  // what is missing is left out
+  std::filesystem::remove_all (root / "sys");
+  std::filesystem::remove (root / "proc/meminfo");
+  const std::string report = uncached.render ();
+  EXPECT_EQ (report.find ("Temperature"), std::string::npos);
+  EXPECT_EQ (report.find ("Memory"), std::string::npos);
+  EXPECT_NE (report.find ("Load: 2.50"), std::string::npos);
+  std::filesystem::remove_all (root);
+}
+
+TEST (SystemInfo, FormatsUptime) {
+  EXPECT_EQ (SystemInfo::formatUptime (59), "0 mins");
+  EXPECT_EQ (SystemInfo::formatUptime (3660), "1 hour, 1 min");
+  EXPECT_EQ (SystemInfo::formatUptime (86400 + 120), "1 day, 0 hours, 2 mins");
+}
@@ -0,0 +1,129 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include <Scheduler/Scheduler.hpp>
+#include <Scheduler/TimerWheel.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using dotname::Scheduler;
+using dotname::TimerWheel;
+using namespace std::chrono_literals;
+
+TEST (TimerWheel, ExpiresEveryEntryAtItsTickAcrossLevels) {
+  TimerWheel wheel (1000);
+  std::mt19937_64 random (7);
+  std::vector<std::pair<std::uint64_t, std::uint64_t> > added;
+  // delays covering all four levels, including the digit boundaries
+  for (std::uint64_t delay : { 1ull, 255ull, 256ull, 257ull, 65535ull, 65536ull, 16777216ull }) {
+    added.emplace_back (added.size (), 1000 + delay);
+  }
+  for (int i = 0; i < 2000; ++i) {
+    added.emplace_back (added.size (), 1000 + 1 + random () % 200000);
+  }
+  for (const auto& [id, expiry] : added) {
+    wheel.add (id, expiry);
+  }
+  EXPECT_EQ (wheel.size (), added.size ());
+
+  std::vector<std::pair<std::uint64_t, std::uint64_t> > expired;
+  std::uint64_t last = 0;
+  bool inOrder = true;
+  wheel.advance (1000 + 16777216, [&] (std::uint64_t id, std::uint64_t expiry) {
+    EXPECT_EQ (wheel.now (), expiry);
+    inOrder = inOrder && expiry >= last;
+    last = expiry;
+    expired.emplace_back (id, expiry);
+  });
+  EXPECT_TRUE (inOrder);
+  EXPECT_EQ (wheel.size (), 0u);
+  ASSERT_EQ (expired.size (), added.size ());
+  for (const auto& [id, expiry] : expired) {
+    EXPECT_EQ (added[id].second, expiry);
+  }
+}
+
+TEST (TimerWheel, ClampsPastAndFarExpiries) {
+  TimerWheel wheel (50);
+  wheel.add (1, 10);
+  wheel.add (2, 50 + TimerWheel::maxDelay * 2);
+
+  std::vector<std::uint64_t> ticks;
+  wheel.advance (51, [&] (std::uint64_t id, std::uint64_t) { ticks.push_back (id); });
+  EXPECT_EQ (ticks, std::vector<std::uint64_t>{ 1 });
+  EXPECT_EQ (wheel.size (), 1u);
+}
+
+TEST (TimerWheel, ExpireMayAddEntries) {
+  TimerWheel wheel;
+  wheel.add (0, 3);
+  int runs = 0;
+  wheel.advance (300, [&] (std::uint64_t id, std::uint64_t expiry) {
+    ++runs;
+    wheel.add (id, expiry + 100);
+  });
+  EXPECT_EQ (runs, 3); // at 3, 103 and 203
+  EXPECT_EQ (wheel.size (), 1u);
+}
+
+TEST (Scheduler, RunsCancelsAndAlignsJobs) {
+  Scheduler scheduler (2, 1ms);
+  std::atomic<int> once{ 0 };
+  std::atomic<int> periodic{ 0 };
+  std::atomic<int> cancelled{ 0 };
+
+  scheduler.after (5ms, [&] { ++once; });
+  const Scheduler::JobId every = scheduler.every (2ms, [&] { ++periodic; }, 1ms);
+  const Scheduler::JobId never = scheduler.after (200ms, [&] { ++cancelled; });
+  EXPECT_TRUE (scheduler.cancel (never));
+  EXPECT_FALSE (scheduler.cancel (never));
+  EXPECT_EQ (scheduler.daily (24, 0, [] {}), Scheduler::noJob);
+
+  for (int i = 0; i < 200 && (once.load () == 0 || periodic.load () < 5); ++i) {
+    std::this_thread::sleep_for (5ms);
+  }
+  EXPECT_EQ (once.load (), 1);
+  EXPECT_GE (periodic.load (), 5);
+  EXPECT_TRUE (scheduler.cancel (every));
+  EXPECT_EQ (scheduler.jobCount (), 0u);
+  EXPECT_EQ (cancelled.load (), 0);
+
+  const std::chrono::seconds left = Scheduler::untilWallClock (6, 0);
+  EXPECT_GT (left, 0s);
+  EXPECT_LE (left, 25h);
+}
+
+TEST (Scheduler, ShutdownStopsRunningJobsWithinTimeout) {
+  Scheduler scheduler (1, 1ms);
+  std::atomic<bool> started{ false };
+  std::atomic<bool> stopped{ false };
+  const dotname::StopToken token = scheduler.stopToken ();
+  scheduler.after (0ms, [&] {
+    started = true;
+    while (!token.stopRequested ()) {
+      std::this_thread::sleep_for (1ms);
+    }
+    stopped = true;
+  });
+  std::atomic<int> queued{ 0 };
+  scheduler.every (1ms, [&] { ++queued; });
+  for (int i = 0; i < 1000 && !started.load (); ++i) {
+    std::this_thread::sleep_for (1ms);
+  }
+  ASSERT_TRUE (started.load ());
+
+  EXPECT_TRUE (scheduler.shutdown (1s));
+  EXPECT_TRUE (stopped.load ());
+  // the single worker was busy, the periodic job never got it
+  EXPECT_EQ (queued.load (), 0);
+  EXPECT_EQ (scheduler.jobCount (), 0u);
+  EXPECT_EQ (scheduler.after (0ms, [] {}), Scheduler::noJob);
+  EXPECT_TRUE (scheduler.shutdown (1s));
+}
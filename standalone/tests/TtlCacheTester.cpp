@@ -0,0 +1,101 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include <Cache/TtlCache.hpp>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Cache = dotname::TtlCache<std::string>;
+using namespace std::chrono_literals;
+
+// Loader that parks its completions until the test releases them
+struct ManualLoader {
+  std::vector<Cache::Complete> pending;
+  int calls = 0;
+
+  Cache::Loader loader () {
+    return [this] (Cache::Complete complete) {
+      ++calls;
+      pending.push_back (std::move (complete));
+    };
+  }
+  void release (bool ok, const std::string& value) {
+    std::vector<Cache::Complete> completes;
+    completes.swap (pending);
+    for (Cache::Complete& complete : completes) {
+      complete (ok, value);
+    }
+  }
+};
+
+TEST (TtlCache, CoalescesConcurrentMisses) {
+  Cache cache;
+  ManualLoader source;
+  const Cache::Policy policy{ 1h, 0s };
+
+  std::vector<std::string> served;
+  for (int i = 0; i < 5; ++i) {
+    cache.fetch ("btc", policy, source.loader (),
+                 [&] (const std::string* value) { served.push_back (value ? *value : "-"); });
+  }
+  EXPECT_EQ (source.calls, 1);
+  EXPECT_TRUE (served.empty ());
+
+  source.release (true, "1 BTC");
+  EXPECT_EQ (served, std::vector<std::string> (5, "1 BTC"));
+
+  // fresh hit, no load
+  std::string value;
+  EXPECT_TRUE (cache.lookup ("btc", policy, source.loader (), value));
+  EXPECT_EQ (value, "1 BTC");
+  EXPECT_EQ (source.calls, 1);
+}
+
+TEST (TtlCache, ServesStaleWhileRevalidating) {
+  Cache cache;
+  ManualLoader source;
+  const Cache::Policy policy{ 1ms, 1h };
+
+  cache.fetch ("czk", policy, source.loader (), [] (const std::string*) {});
+  source.release (true, "old");
+  std::this_thread::sleep_for (5ms);
+
+  std::string value;
+  EXPECT_TRUE (cache.lookup ("czk", policy, source.loader (), value));
+  EXPECT_EQ (value, "old");
+  EXPECT_TRUE (cache.lookup ("czk", policy, source.loader (), value));
+  EXPECT_EQ (source.calls, 2); // one revalidation for both stale hits
+
+  source.release (true, "new");
+  EXPECT_TRUE (cache.lookup ("czk", Cache::Policy{ 1h, 0s }, source.loader (), value));
+  EXPECT_EQ (value, "new");
+}
+
+TEST (TtlCache, FallsBackToLastValueOnError) {
+  Cache cache;
+  ManualLoader source;
+  const Cache::Policy expired{ 0s, 0s };
+
+  const std::string* missing = reinterpret_cast<const std::string*> (1);
+  cache.fetch ("rss", expired, source.loader (), [&] (const std::string* v) { missing = v; });
+  source.release (false, "");
+  EXPECT_EQ (missing, nullptr);
+
+  cache.fetch ("rss", expired, source.loader (), [] (const std::string*) {});
+  source.release (true, "feed");
+
+  std::string served;
+  cache.fetch ("rss", expired, source.loader (),
+               [&] (const std::string* v) { served = v ? *v : "-"; });
+  source.release (false, "");
+  EXPECT_EQ (served, "feed");
+
+  std::string last;
+  EXPECT_TRUE (cache.peek ("rss", last)); // expired, but still known
+  EXPECT_EQ (last, "feed");
+  EXPECT_FALSE (cache.peek ("btc", last));
+}
@@ -0,0 +1,126 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include <Bible/VerseIndex.hpp>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+static const std::filesystem::path kralicky
+    = std::filesystem::path (TEST_ASSETS_DIR) / "kralicky.txt";
+
+// A copy in a temp dir, loading writes kralicky.idx next to it and not into the sources
+static const std::filesystem::path& kralickyCopy () {
+  static const std::filesystem::path text = [] {
+    const std::filesystem::path dir
+        = std::filesystem::temp_directory_path () / "MyDppVerseIndexTesterText";
+    std::filesystem::create_directories (dir);
+    const std::filesystem::path copy = dir / "kralicky.txt";
+    std::filesystem::copy_file (kralicky, copy, std::filesystem::copy_options::overwrite_existing);
+    return copy;
+  }();
+  return text;
+}
+
+TEST (VerseIndex, IndexesWholeBible) {
+  dotname::VerseIndex index;
+  ASSERT_TRUE (index.load (kralickyCopy ()));
+  EXPECT_EQ (index.bookCount (), 66u);
+  EXPECT_EQ (index.chapterCount (), 1189u);
+  EXPECT_GT (index.verseCount (), 31000u);
+}
+
+TEST (VerseIndex, ServesVerseSpans) {
+  dotname::VerseIndex index;
+  ASSERT_TRUE (index.load (kralickyCopy ()));
+
+  dotname::VerseIndex::Verse first = index.verseAt (0);
+  EXPECT_EQ (first.heading, "Genesis 1");
+  EXPECT_EQ (first.book, "Genesis");
+  EXPECT_EQ (first.chapter, 1);
+  EXPECT_EQ (first.number, 1);
+  EXPECT_EQ (first.text, "1 Na počátku stvořil Bůh nebe a zemi.");
+
+  dotname::VerseIndex::Verse last = index.verseAt (index.verseCount () - 1);
+  EXPECT_EQ (last.heading, "Zjevení Janovo 22");
+  EXPECT_EQ (last.number, 21);
+}
+
+TEST (VerseIndex, MissingFile) {
+  dotname::VerseIndex index;
+  EXPECT_FALSE (index.load ("does-not-exist.txt"));
+  EXPECT_FALSE (index.isLoaded ());
+}
+
+TEST (VerseIndex, PersistsIndexFile) {
+  const std::filesystem::path dir
+      = std::filesystem::temp_directory_path () / "MyDppVerseIndexTester";
+  std::filesystem::remove_all (dir);
+  std::filesystem::create_directories (dir);
+  const std::filesystem::path text = dir / "kralicky.txt";
+  std::filesystem::copy_file (kralicky, text);
+  const std::filesystem::path indexFile = dotname::VerseIndex::indexPathFor (text);
+
+  dotname::VerseIndex built;
+  ASSERT_TRUE (built.load (text));
+  EXPECT_FALSE (built.isFromIndexFile ());
+  ASSERT_TRUE (std::filesystem::exists (indexFile));
+
+  dotname::VerseIndex mapped;
+  ASSERT_TRUE (mapped.load (text));
+  EXPECT_TRUE (mapped.isFromIndexFile ());
+  EXPECT_EQ (mapped.verseCount (), built.verseCount ());
+  EXPECT_EQ (mapped.chapterCount (), built.chapterCount ());
+  EXPECT_EQ (mapped.bookCount (), built.bookCount ());
+  EXPECT_EQ (mapped.verseAt (12345).text, built.verseAt (12345).text);
+  EXPECT_EQ (mapped.verseAt (12345).heading, built.verseAt (12345).heading);
+
+  // a corrupted index is detected and rebuilt
+  {
+    std::fstream file (indexFile, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp (100);
+    file.put ('\x7f');
+  }
+  dotname::VerseIndex rebuilt;
+  ASSERT_TRUE (rebuilt.load (text));
+  EXPECT_FALSE (rebuilt.isFromIndexFile ());
+  EXPECT_EQ (rebuilt.verseAt (0).text, "1 Na počátku stvořil Bůh nebe a zemi.");
+
+  std::filesystem::remove_all (dir);
+}
+
+TEST (VerseIndex, FindsReferences) {
+  dotname::VerseIndex index;
+  ASSERT_TRUE (index.load (kralickyCopy ()));
+
+  const std::size_t genesis = index.findBook ("Genesis");
+  ASSERT_NE (genesis, dotname::VerseIndex::npos);
+  EXPECT_EQ (index.findBook ("genesis"), genesis);
+  EXPECT_EQ (index.findBook ("Gen"), genesis);
+  EXPECT_NE (index.findBook ("1 Samuelova"), dotname::VerseIndex::npos);
+  EXPECT_EQ (index.findBook ("1samuelova"), index.findBook ("1 Samuelova"));
+  EXPECT_EQ (index.findBook ("Zidum"), index.findBook ("Židům"));
+  EXPECT_EQ (index.findBook ("Nic"), dotname::VerseIndex::npos);
+  // U+0231 ends in the byte of '1' and still is no digit
+  EXPECT_EQ (index.findBook ("Gen\u0231"), genesis);
+
+  std::size_t id = index.findVerse (genesis, 1, 3);
+  ASSERT_NE (id, dotname::VerseIndex::npos);
+  EXPECT_EQ (index.verseAt (id).text, "3 I řekl Bůh: Buď světlo! I bylo světlo.");
+  EXPECT_EQ (index.findVerse (genesis, 51, 1), dotname::VerseIndex::npos);
+  EXPECT_EQ (index.findVerse (genesis, 1, 99), dotname::VerseIndex::npos);
+
+  std::size_t first = 0;
+  std::size_t count = 0;
+  ASSERT_TRUE (index.findReference ("Jan 3:16-18", first, count));
+  EXPECT_EQ (count, 3u);
+  EXPECT_EQ (index.verseAt (first).heading, "Jan 3");
+  EXPECT_EQ (index.verseAt (first).number, 16);
+  ASSERT_TRUE (index.findReference ("Jan 3,16", first, count));
+  EXPECT_EQ (count, 1u);
+  ASSERT_TRUE (index.findReference ("Žalmy 117", first, count));
+  EXPECT_EQ (count, 2u);
+  EXPECT_FALSE (index.findReference ("Jan", first, count));
+  EXPECT_FALSE (index.findReference ("Jan 3:18-16", first, count));
+}
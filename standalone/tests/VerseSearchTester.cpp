@@ -0,0 +1,66 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include <Bible/VerseIndex.hpp>
+#include <Bible/VerseSearch.hpp>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+
+static const std::filesystem::path kralicky
+    = std::filesystem::path (TEST_ASSETS_DIR) / "kralicky.txt";
+
+// A copy in a temp dir, loading writes kralicky.idx next to it and not into the sources
+static const std::filesystem::path& kralickyCopy () {
+  static const std::filesystem::path text = [] {
+    const std::filesystem::path dir
+        = std::filesystem::temp_directory_path () / "MyDppVerseSearchTesterText";
+    std::filesystem::create_directories (dir);
+    const std::filesystem::path copy = dir / "kralicky.txt";
+    std::filesystem::copy_file (kralicky, copy, std::filesystem::copy_options::overwrite_existing);
+    return copy;
+  }();
+  return text;
+}
+
+TEST (VerseSearch, FoldsDiacritics) {
+  std::vector<std::string> tokens;
+  dotname::VerseSearch::tokenize ("1 Na počátku stvořil Bůh nebe a zemi.", tokens);
+  std::vector<std::string> expected = { "na", "pocatku", "stvoril", "buh", "nebe", "a", "zemi" };
+  EXPECT_EQ (tokens, expected);
+}
+
+TEST (VerseSearch, FindsVersesWithAllWords) {
+  dotname::VerseIndex index;
+  ASSERT_TRUE (index.load (kralickyCopy ()));
+  dotname::VerseSearch search;
+  ASSERT_TRUE (search.build (index));
+
+  std::size_t total = 0;
+  std::vector<std::uint32_t> ids = search.find ("Počátku STVOŘIL", 10, &total);
+  ASSERT_FALSE (ids.empty ());
+  EXPECT_EQ (ids.front (), 0u);
+  EXPECT_EQ (search.find ("pocatku stvoril", 10), ids);
+
+  // compare the galloping intersection against a plain scan
+  std::vector<std::uint32_t> all = search.find ("buh a zemi", 100000, &total);
+  std::vector<std::uint32_t> scanned;
+  std::vector<std::string> tokens;
+  for (std::uint32_t id = 0; id < index.verseCount (); ++id) {
+    tokens.clear ();
+    dotname::VerseSearch::tokenize (index.verseAt (id).text, tokens);
+    auto has = [&] (const char* word) {
+      return std::find (tokens.begin (), tokens.end (), word) != tokens.end ();
+    };
+    if (has ("buh") && has ("a") && has ("zemi")) {
+      scanned.push_back (id);
+    }
+  }
+  EXPECT_EQ (all, scanned);
+  EXPECT_EQ (total, scanned.size ());
+
+  EXPECT_EQ (search.find ("buh", 3).size (), 3u);
+  EXPECT_TRUE (search.find ("buh neexistujicislovo", 10).empty ());
+  EXPECT_TRUE (search.find ("...", 10).empty ());
+}